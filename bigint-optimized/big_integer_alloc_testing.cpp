@@ -0,0 +1,166 @@
+#include <cstdlib>
+#include <new>
+#include <gtest/gtest.h>
+
+#include "big_integer.h"
+#include "wide_integer.h"
+
+// every allocation of the process goes through here, so a test can check that a block of big_integer operations
+// on values held in the inline storage of small_object_shared_vector never touches the heap
+namespace {
+size_t allocations = 0;
+}
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+#define EXPECT_NO_ALLOCATIONS(statements)                  \
+  do {                                                     \
+    size_t before = allocations;                           \
+    { statements; }                                        \
+    size_t count = allocations - before;                   \
+    EXPECT_EQ(0u, count) << #statements;                   \
+  } while (false)
+
+TEST(allocations, counter_works) {
+  size_t before = allocations;
+  delete new int(1);
+  EXPECT_EQ(1u, allocations - before);
+}
+
+TEST(allocations, construction) {
+  big_integer a = 5;
+  EXPECT_NO_ALLOCATIONS(big_integer b);
+  EXPECT_NO_ALLOCATIONS(big_integer b = -7);
+  EXPECT_NO_ALLOCATIONS(big_integer b = a);
+  EXPECT_NO_ALLOCATIONS(big_integer b; b = a);
+  EXPECT_NO_ALLOCATIONS(big_integer b = -a);
+  EXPECT_NO_ALLOCATIONS(big_integer b = +a);
+}
+
+TEST(allocations, move) {
+  // heap-sized values, so the buffers really change hands; the plain limb_vector policy is instantiated here too
+  big_integer a = big_integer(1) << 500;
+  EXPECT_NO_ALLOCATIONS(big_integer b(std::move(a)); a = std::move(b); b = std::move(a); a = std::move(b));
+  EXPECT_EQ(a, big_integer(1) << 500);
+
+  using plain_big_integer = basic_big_integer<uint64_t, limb_vector<uint64_t>>;
+  plain_big_integer c = plain_big_integer(-1) << 500;
+  EXPECT_NO_ALLOCATIONS(plain_big_integer d(std::move(c)); c = std::move(d); d = std::move(c); c = std::move(d));
+  EXPECT_EQ(c, plain_big_integer(-1) << 500);
+  EXPECT_NO_ALLOCATIONS(plain_big_integer d(std::move(c)); plain_big_integer e; e = std::move(c));
+  EXPECT_EQ(c, 0);
+}
+
+TEST(allocations, comparisons) {
+  big_integer a("12345678901234567");
+  big_integer b("-12345678901234567");
+  big_integer c = 42;
+  bool r = false;
+  EXPECT_NO_ALLOCATIONS(r = a == b);
+  EXPECT_NO_ALLOCATIONS(r = a != c);
+  EXPECT_NO_ALLOCATIONS(r = a < b);
+  EXPECT_NO_ALLOCATIONS(r = b <= c);
+  EXPECT_NO_ALLOCATIONS(r = c > a);
+  EXPECT_NO_ALLOCATIONS(r = c >= 42);
+  EXPECT_TRUE(r);
+}
+
+TEST(allocations, increments) {
+  big_integer a = -2;
+  EXPECT_NO_ALLOCATIONS(for (int i = 0; i < 4; i++) { ++a; });
+  EXPECT_EQ(a, 2);
+  EXPECT_NO_ALLOCATIONS(a--; a++; --a);
+  EXPECT_EQ(a, 1);
+
+  big_integer b("4294967295");
+  EXPECT_NO_ALLOCATIONS(++b);
+  EXPECT_EQ(b, big_integer("4294967296"));
+  EXPECT_NO_ALLOCATIONS(--b);
+  EXPECT_EQ(b, big_integer("4294967295"));
+
+  // a 20-digit string is read into three limbs, so the two-limb value is built by a shift
+  big_integer c = -2147483647;
+  c <<= 33;
+  EXPECT_NO_ALLOCATIONS(--c);
+  EXPECT_EQ(c, big_integer("-18446744065119617025"));
+}
+
+TEST(allocations, small_arithmetic) {
+  big_integer a = 1000000007;
+  big_integer b = -65537;
+  big_integer r;
+  EXPECT_NO_ALLOCATIONS(r = a + b);
+  EXPECT_NO_ALLOCATIONS(r = a - b);
+  EXPECT_NO_ALLOCATIONS(r += a; r -= b; r += -1; r -= 1);
+  EXPECT_NO_ALLOCATIONS(r = a * b);
+  EXPECT_EQ(r, big_integer("-65537000458759"));
+  EXPECT_NO_ALLOCATIONS(r = a / b);
+  EXPECT_NO_ALLOCATIONS(r = a % b);
+  EXPECT_NO_ALLOCATIONS(r = b / a);
+  EXPECT_NO_ALLOCATIONS(divmod(a, b));
+}
+
+TEST(allocations, small_bit_operations) {
+  big_integer a = 0x7f00ff00;
+  big_integer b = -0x12345;
+  big_integer r;
+  EXPECT_NO_ALLOCATIONS(r = a & b);
+  EXPECT_NO_ALLOCATIONS(r = a | b);
+  EXPECT_NO_ALLOCATIONS(r = a ^ b);
+  EXPECT_NO_ALLOCATIONS(r = ~a);
+  EXPECT_NO_ALLOCATIONS(r = a << 31);
+  EXPECT_NO_ALLOCATIONS(r = b << 40);
+  EXPECT_NO_ALLOCATIONS(r = a >> 5);
+  EXPECT_NO_ALLOCATIONS(r = b >> 100);
+}
+
+TEST(allocations, chain_reuses_buffer) {
+  big_integer a = 1;
+  a <<= 200;
+  big_integer b = 1, c = 2, d = 3;
+  big_integer r;
+  size_t before = allocations;
+  r = a + b;
+  size_t single = allocations - before;
+  before = allocations;
+  r = a + b + c + d;
+  size_t chain = allocations - before;
+  before = allocations;
+  r = d - (a + c);
+  size_t rvalue_rhs = allocations - before;
+  EXPECT_EQ(single, chain);
+  EXPECT_EQ(single, rvalue_rhs);
+  EXPECT_EQ(r, 1 - a);
+}
+
+TEST(allocations, wide_integer) {
+  wide_uint<256> a = 1000000007, b = ~wide_uint<256>(0) / 3, r;
+  wide_int<512> c = -3, s;
+  EXPECT_NO_ALLOCATIONS(r = a * b + a; r -= b; r = r / a % b);
+  EXPECT_NO_ALLOCATIONS(r = ((b << 100) >> 3 ^ a) | (b & ~a); ++r; r--);
+  EXPECT_NO_ALLOCATIONS(s = c * c * c / wide_int<512>(-7); s %= c << 300);
+  EXPECT_EQ(s, 3);
+}
+
+TEST(allocations, literal) {
+  wide_int<256> w;
+  EXPECT_NO_ALLOCATIONS(w = 1234567890123456789012345678901234567890_bi * -7_bi);
+  big_integer b;
+  EXPECT_NO_ALLOCATIONS(b = 1234567890_bi);
+  EXPECT_EQ(b, 1234567890);
+}
@@ -1,3 +1,4 @@
+#include <utility>
 #include <vector>
 
 template<typename T>
@@ -21,6 +22,9 @@ class shared_vector {
   }
 
   void unshare() {
+    if (data_ == nullptr) {
+      return;
+    }
     data_->ref_counter--;
     if (data_->ref_counter == 0) {
       delete data_;
@@ -36,6 +40,11 @@ class shared_vector {
     data_->ref_counter++;
   }
 
+  // the moved-from vector holds no buffer and may only be assigned to or destroyed
+  shared_vector(shared_vector<T> &&other) noexcept: data_(other.data_) {
+    other.data_ = nullptr;
+  }
+
   shared_vector(T *first, T *last) {
     data_ = new data_type(first, last);
   }
@@ -62,6 +71,11 @@ class shared_vector {
     return *this;
   }
 
+  shared_vector &operator=(shared_vector<T> &&other) noexcept {
+    std::swap(data_, other.data_);
+    return *this;
+  }
+
   void push_back(T const &val) {
     own();
     data_->data_impl.push_back(val);
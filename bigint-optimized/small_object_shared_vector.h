@@ -19,11 +19,28 @@ class small_object_shared_vector {
     is_small = false;
   }
 
-  void swap_data(small_object_shared_vector<T> &a, small_object_shared_vector<T> &b) {
-    shared_vector<T> tmp(b.dynamic_data_);
-    b.dynamic_data_.~shared_vector();
-    safe_copy_static(a.static_data_, b.static_data_, a.size_);
-    new(&a.dynamic_data_) shared_vector<T>(tmp);
+  // the buffer of big is moved out and back in, so its reference counter never changes on the way
+  void swap_data(small_object_shared_vector<T> &small, small_object_shared_vector<T> &big) {
+    shared_vector<T> buffer(std::move(big.dynamic_data_));
+    big.dynamic_data_.~shared_vector();
+    safe_copy_static(small.static_data_, big.static_data_, small.size_);
+    small.destroy_small();
+    new(&small.dynamic_data_) shared_vector<T>(std::move(buffer));
+  }
+
+  // only the live elements change places, the slots past the shorter size are never read
+  void swap_static(small_object_shared_vector<T> &other) {
+    using std::swap;
+    small_object_shared_vector<T> &shorter = size_ < other.size_ ? *this : other;
+    small_object_shared_vector<T> &longer = size_ < other.size_ ? other : *this;
+    size_t i = 0;
+    for (; i < shorter.size_; i++) {
+      swap(static_data_[i], other.static_data_[i]);
+    }
+    for (; i < longer.size_; i++) {
+      new(shorter.static_data_ + i) T(std::move(longer.static_data_[i]));
+      longer.static_data_[i].~T();
+    }
   }
 
   void safe_copy_static(T const *from, T *to, size_t size) {
@@ -68,6 +85,23 @@ class small_object_shared_vector {
     }
   }
 
+  // a dynamic buffer changes hands without touching its reference counter; the source is left small, holding a
+  // single value-initialized element, so it stays readable without an allocation
+  small_object_shared_vector(small_object_shared_vector<T> &&other) noexcept
+      : size_(other.size_), is_small(other.is_small) {
+    if (is_small) {
+      for (size_t i = 0; i < size_; i++) {
+        new(static_data_ + i) T(std::move(other.static_data_[i]));
+      }
+    } else {
+      new(&dynamic_data_) shared_vector<T>(std::move(other.dynamic_data_));
+      other.dynamic_data_.~shared_vector();
+      other.is_small = true;
+      new(other.static_data_) T();
+      other.size_ = 1;
+    }
+  }
+
   ~small_object_shared_vector() {
     if (is_small) {
       destroy_small();
@@ -98,25 +132,35 @@ class small_object_shared_vector {
     }
   }
 
-  small_object_shared_vector &operator=(small_object_shared_vector<T> const &other) {
-    if (this != &other) {
-      using std::swap;
-      small_object_shared_vector<T> tmp(other);
-      if (is_small == tmp.is_small) {
-        if (is_small) {
-          swap(static_data_, tmp.static_data_);
-        } else {
-          swap(dynamic_data_, tmp.dynamic_data_);
-        }
+  void swap(small_object_shared_vector<T> &other) {
+    using std::swap;
+    if (is_small == other.is_small) {
+      if (is_small) {
+        swap_static(other);
       } else {
-        if (is_small) {
-          swap_data(*this, tmp);
-        } else {
-          swap_data(tmp, *this);
-        }
+        swap(dynamic_data_, other.dynamic_data_);
       }
-      swap(is_small, tmp.is_small);
-      swap(size_, tmp.size_);
+    } else {
+      if (is_small) {
+        swap_data(*this, other);
+      } else {
+        swap_data(other, *this);
+      }
+    }
+    swap(is_small, other.is_small);
+    swap(size_, other.size_);
+  }
+
+  small_object_shared_vector &operator=(small_object_shared_vector<T> const &other) {
+    small_object_shared_vector<T> tmp(other);
+    swap(tmp);
+    return *this;
+  }
+
+  small_object_shared_vector &operator=(small_object_shared_vector<T> &&other) noexcept {
+    if (this != &other) {
+      this->~small_object_shared_vector();
+      new(this) small_object_shared_vector<T>(std::move(other));
     }
     return *this;
   }
@@ -153,7 +197,7 @@ class small_object_shared_vector {
         from_small_to_big();
       }
       if (is_small) {
-        safe_initialize_with_static(static_data_, size_, size_ + n, val);
+        safe_initialize_with_static(static_data_, size_, n, val);
       } else {
         dynamic_data_.resize(n, val);
       }
@@ -2,49 +2,534 @@
 
 #include <cstring>
 #include <climits>
-#include <functional>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
 
-const big_integer ZERO(0);
+#if defined(__x86_64__) && !defined(BIG_INTEGER_PORTABLE)
+#include <cpuid.h>
+#endif
 
-big_integer::big_integer() : sign_(false), data_({0}) {}
+namespace {
+__extension__ typedef unsigned __int128 uint128_t;
 
-big_integer::big_integer(int a) : sign_(a < 0) {
-  data_.push_back(a == INT_MIN ? static_cast<uint32_t>(INT_MAX) + 1 : static_cast<uint32_t>(std::abs(a)));
+// three NTT-friendly primes below 2^31, each with a 2^24-th root of unity; their product exceeds 2^89
+constexpr uint32_t NTT_MOD_1 = 2013265921, NTT_ROOT_1 = 31;
+constexpr uint32_t NTT_MOD_2 = 469762049, NTT_ROOT_2 = 3;
+constexpr uint32_t NTT_MOD_3 = 754974721, NTT_ROOT_3 = 11;
+
+template<uint32_t MOD>
+uint32_t pow_mod(uint32_t a, uint32_t e) {
+  uint64_t res = 1, cur = a;
+  for (; e > 0; e >>= 1u) {
+    if (e & 1u) {
+      res = res * cur % MOD;
+    }
+    cur = cur * cur % MOD;
+  }
+  return static_cast<uint32_t>(res);
+}
+
+// -MOD^(-1) mod 2^32 by Newton's iteration, each step doubles the number of correct bits
+constexpr uint32_t neg_inverse(uint32_t mod, uint32_t x, int steps) {
+  return steps == 0 ? 0u - x : neg_inverse(mod, x * (2u - mod * x), steps - 1);
+}
+
+// Montgomery reduction: t * 2^(-32) mod MOD for t < MOD * 2^32
+template<uint32_t MOD>
+uint32_t redc(uint64_t t) {
+  constexpr uint32_t NEG_INV = neg_inverse(MOD, MOD, 5);
+  uint32_t q = static_cast<uint32_t>(t) * NEG_INV;
+  uint64_t res = (t + static_cast<uint64_t>(q) * MOD) >> 32u;
+  return static_cast<uint32_t>(res >= MOD ? res - MOD : res);
+}
+
+template<uint32_t MOD>
+uint32_t to_montgomery(uint32_t a) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(a) << 32u) % MOD);
+}
+
+// twiddles are kept in Montgomery form, so multiplying by them leaves the data in the ordinary one
+template<uint32_t MOD, uint32_t ROOT>
+void ntt(std::vector<uint32_t> &a, bool invert) {
+  size_t n = a.size();
+  for (size_t i = 1, j = 0; i < n; i++) {
+    size_t bit = n >> 1u;
+    for (; j & bit; bit >>= 1u) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(a[i], a[j]);
+    }
+  }
+  std::vector<uint32_t> w(n / 2);
+  for (size_t len = 2; len <= n; len <<= 1u) {
+    size_t half = len / 2;
+    uint32_t w_len = pow_mod<MOD>(ROOT, static_cast<uint32_t>((MOD - 1) / len));
+    if (invert) {
+      w_len = pow_mod<MOD>(w_len, MOD - 2);
+    }
+    w[0] = to_montgomery<MOD>(1);
+    w_len = to_montgomery<MOD>(w_len);
+    for (size_t j = 1; j < half; j++) {
+      w[j] = redc<MOD>(static_cast<uint64_t>(w[j - 1]) * w_len);
+    }
+    for (size_t i = 0; i < n; i += len) {
+      uint32_t *lo = a.data() + i, *hi = lo + half;
+      for (size_t j = 0; j < half; j++) {
+        uint32_t u = lo[j];
+        uint32_t v = redc<MOD>(static_cast<uint64_t>(hi[j]) * w[j]);
+        lo[j] = u + v < MOD ? u + v : u + v - MOD;
+        hi[j] = u >= v ? u - v : u + MOD - v;
+      }
+    }
+  }
+}
+
+template<uint32_t MOD, uint32_t ROOT>
+std::vector<uint32_t> convolution(uint32_t const *a, size_t n, uint32_t const *b, size_t m, size_t size) {
+  std::vector<uint32_t> fa(size);
+  for (size_t i = 0; i < n; i++) {
+    fa[i] = a[i] % MOD;
+  }
+  ntt<MOD, ROOT>(fa, false);
+  if (a == b && n == m) {
+    for (size_t i = 0; i < size; i++) {
+      fa[i] = redc<MOD>(static_cast<uint64_t>(fa[i]) * fa[i]);
+    }
+  } else {
+    std::vector<uint32_t> fb(size);
+    for (size_t i = 0; i < m; i++) {
+      fb[i] = b[i] % MOD;
+    }
+    ntt<MOD, ROOT>(fb, false);
+    for (size_t i = 0; i < size; i++) {
+      fa[i] = redc<MOD>(static_cast<uint64_t>(fa[i]) * fb[i]);
+    }
+  }
+  ntt<MOD, ROOT>(fa, true);
+  // the pointwise products lost a factor of 2^32, the inverse transform gained one of size
+  uint32_t scale = to_montgomery<MOD>(to_montgomery<MOD>(pow_mod<MOD>(static_cast<uint32_t>(size), MOD - 2)));
+  for (size_t i = 0; i < size; i++) {
+    fa[i] = redc<MOD>(static_cast<uint64_t>(fa[i]) * scale);
+  }
+  return fa;
+}
+
+// n + m <= 2^24: convolve modulo three primes and restore every coefficient with Garner's CRT
+void ntt_multiply(uint32_t *res, uint32_t const *a, size_t n, uint32_t const *b, size_t m) {
+  size_t size = 1;
+  while (size < n + m) {
+    size <<= 1u;
+  }
+  std::vector<uint32_t> c1 = convolution<NTT_MOD_1, NTT_ROOT_1>(a, n, b, m, size),
+      c2 = convolution<NTT_MOD_2, NTT_ROOT_2>(a, n, b, m, size),
+      c3 = convolution<NTT_MOD_3, NTT_ROOT_3>(a, n, b, m, size);
+
+  uint64_t const inv_1 = pow_mod<NTT_MOD_2>(NTT_MOD_1 % NTT_MOD_2, NTT_MOD_2 - 2);
+  uint64_t const mod_12 = static_cast<uint64_t>(NTT_MOD_1) * NTT_MOD_2;
+  uint64_t const inv_12 = pow_mod<NTT_MOD_3>(mod_12 % NTT_MOD_3, NTT_MOD_3 - 2);
+  uint128_t carry = 0;
+  for (size_t i = 0; i < n + m; i++) {
+    uint64_t y1 = c1[i];
+    uint64_t y2 = (c2[i] + NTT_MOD_2 - y1 % NTT_MOD_2) * inv_1 % NTT_MOD_2;
+    uint64_t y12 = (y1 + y2 * NTT_MOD_1) % NTT_MOD_3;
+    uint64_t y3 = (c3[i] + NTT_MOD_3 - y12) * inv_12 % NTT_MOD_3;
+    carry += y1 + static_cast<uint128_t>(y2) * NTT_MOD_1 + static_cast<uint128_t>(y3) * mod_12;
+    res[i] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
+  }
+}
+
+// 64-bit limbs are convolved as pairs of 32-bit halves, which keeps every coefficient below the CRT bound
+void ntt_multiply(uint64_t *res, uint64_t const *a, size_t n, uint64_t const *b, size_t m) {
+  std::vector<uint32_t> sa(2 * n), sb(a == b && n == m ? 0 : 2 * m), prod(2 * (n + m));
+  for (size_t i = 0; i < n; i++) {
+    sa[2 * i] = static_cast<uint32_t>(a[i]);
+    sa[2 * i + 1] = static_cast<uint32_t>(a[i] >> 32u);
+  }
+  for (size_t i = 0; i < sb.size() / 2; i++) {
+    sb[2 * i] = static_cast<uint32_t>(b[i]);
+    sb[2 * i + 1] = static_cast<uint32_t>(b[i] >> 32u);
+  }
+  ntt_multiply(prod.data(), sa.data(), 2 * n, sb.empty() ? sa.data() : sb.data(), 2 * m);
+  for (size_t i = 0; i < n + m; i++) {
+    res[i] = prod[2 * i] | static_cast<uint64_t>(prod[2 * i + 1]) << 32u;
+  }
+}
+
+// limb kernels that beat the portable loops on the running CPU; the primary template has none, so its checks fold
+// away and every caller keeps the plain C++ loops. Only uint64_t has a specialization: the 32-bit limbs of
+// big_integer would need a second set of asm loops, and big_integer64 does the same work in half the iterations
+template <typename Limb>
+struct limb_kernels {
+  static constexpr bool available() {
+    return false;
+  }
+  static Limb add_n(Limb *, Limb const *, Limb const *, size_t) {
+    return 0;
+  }
+  static Limb sub_n(Limb *, Limb const *, Limb const *, size_t) {
+    return 0;
+  }
+  static Limb mul_1(Limb *, Limb const *, size_t, Limb) {
+    return 0;
+  }
+  static Limb addmul_1(Limb *, Limb const *, size_t, Limb) {
+    return 0;
+  }
+  static Limb submul_1(Limb *, Limb const *, size_t, Limb) {
+    return 0;
+  }
+};
+
+#if defined(__x86_64__) && !defined(BIG_INTEGER_PORTABLE)
+// BMI2 gives the flag-free mulx and ADX the adcx/adox pair, which add through CF and OF alone; a multiply row then
+// runs two independent carry chains, one through the products and one through the limbs of res. Compilers keep
+// neither carry in the flags across intrinsics, so the block loops are written in asm, four limbs per iteration,
+// and the n % 4 leading limbs go through a plain step. Both extensions are checked once at start-up; until then,
+// and on CPUs without them, the flag reads false and the portable loops run
+bool has_bmi2_adx() {
+  unsigned eax, ebx, ecx, edx;
+  return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0 && (ebx & bit_BMI2) != 0 && (ebx & bit_ADX) != 0;
+}
+
+bool const bmi2_adx = has_bmi2_adx();
+
+// every kernel reads a[i] and b[i] before it writes res[i], so res may be a or b itself
+uint64_t x86_add_n(uint64_t *res, uint64_t const *a, uint64_t const *b, size_t n) {
+  uint64_t carry = 0;
+  size_t head = n % 4, blocks = n / 4;
+  for (size_t i = 0; i < head; i++) {
+    uint128_t tmp = static_cast<uint128_t>(a[i]) + b[i] + carry;
+    res[i] = static_cast<uint64_t>(tmp);
+    carry = static_cast<uint64_t>(tmp >> 64u);
+  }
+  if (blocks != 0) {
+    uint64_t tmp;
+    res += head, a += head, b += head;
+    // dec leaves CF alone, so the carry runs through the whole loop
+    __asm__("bt $0, %[carry]\n\t"
+            "1:\n\t"
+            "mov (%[a]), %[tmp]\n\t"
+            "adc (%[b]), %[tmp]\n\t"
+            "mov %[tmp], (%[res])\n\t"
+            "mov 8(%[a]), %[tmp]\n\t"
+            "adc 8(%[b]), %[tmp]\n\t"
+            "mov %[tmp], 8(%[res])\n\t"
+            "mov 16(%[a]), %[tmp]\n\t"
+            "adc 16(%[b]), %[tmp]\n\t"
+            "mov %[tmp], 16(%[res])\n\t"
+            "mov 24(%[a]), %[tmp]\n\t"
+            "adc 24(%[b]), %[tmp]\n\t"
+            "mov %[tmp], 24(%[res])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[b]), %[b]\n\t"
+            "lea 32(%[res]), %[res]\n\t"
+            "dec %[blocks]\n\t"
+            "jnz 1b\n\t"
+            "setc %b[carry]"
+            : [res] "+r"(res), [a] "+r"(a), [b] "+r"(b), [blocks] "+r"(blocks), [carry] "+r"(carry),
+              [tmp] "=&r"(tmp)
+            :
+            : "cc", "memory");
+  }
+  return carry;
+}
+
+uint64_t x86_sub_n(uint64_t *res, uint64_t const *a, uint64_t const *b, size_t n) {
+  uint64_t borrow = 0;
+  size_t head = n % 4, blocks = n / 4;
+  for (size_t i = 0; i < head; i++) {
+    uint128_t tmp = static_cast<uint128_t>(a[i]) - b[i] - borrow;
+    res[i] = static_cast<uint64_t>(tmp);
+    borrow = static_cast<uint64_t>(tmp >> 64u) & 1u;
+  }
+  if (blocks != 0) {
+    uint64_t tmp;
+    res += head, a += head, b += head;
+    __asm__("bt $0, %[borrow]\n\t"
+            "1:\n\t"
+            "mov (%[a]), %[tmp]\n\t"
+            "sbb (%[b]), %[tmp]\n\t"
+            "mov %[tmp], (%[res])\n\t"
+            "mov 8(%[a]), %[tmp]\n\t"
+            "sbb 8(%[b]), %[tmp]\n\t"
+            "mov %[tmp], 8(%[res])\n\t"
+            "mov 16(%[a]), %[tmp]\n\t"
+            "sbb 16(%[b]), %[tmp]\n\t"
+            "mov %[tmp], 16(%[res])\n\t"
+            "mov 24(%[a]), %[tmp]\n\t"
+            "sbb 24(%[b]), %[tmp]\n\t"
+            "mov %[tmp], 24(%[res])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[b]), %[b]\n\t"
+            "lea 32(%[res]), %[res]\n\t"
+            "dec %[blocks]\n\t"
+            "jnz 1b\n\t"
+            "setc %b[borrow]"
+            : [res] "+r"(res), [a] "+r"(a), [b] "+r"(b), [blocks] "+r"(blocks), [borrow] "+r"(borrow),
+              [tmp] "=&r"(tmp)
+            :
+            : "cc", "memory");
+  }
+  return borrow;
+}
+
+// the multiply rows count their blocks down in rcx and leave through jrcxz, the only loop exit that touches
+// neither CF nor OF; mulx takes k from rdx and hi carries the high half of the previous product
+uint64_t x86_mul_1(uint64_t *res, uint64_t const *a, size_t n, uint64_t k) {
+  uint64_t hi = 0;
+  size_t head = n % 4, blocks = n / 4;
+  for (size_t i = 0; i < head; i++) {
+    uint128_t tmp = static_cast<uint128_t>(a[i]) * k + hi;
+    res[i] = static_cast<uint64_t>(tmp);
+    hi = static_cast<uint64_t>(tmp >> 64u);
+  }
+  if (blocks != 0) {
+    uint64_t lo, next;
+    res += head, a += head;
+    __asm__("xor %k[lo], %k[lo]\n\t"
+            "1:\n\t"
+            "mulx (%[a]), %[lo], %[next]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "mov %[lo], (%[res])\n\t"
+            "mulx 8(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[next], %[lo]\n\t"
+            "mov %[lo], 8(%[res])\n\t"
+            "mulx 16(%[a]), %[lo], %[next]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "mov %[lo], 16(%[res])\n\t"
+            "mulx 24(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[next], %[lo]\n\t"
+            "mov %[lo], 24(%[res])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[res]), %[res]\n\t"
+            "lea -1(%[blocks]), %[blocks]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "mov $0, %k[lo]\n\t"
+            "adcx %[lo], %[hi]"
+            : [res] "+r"(res), [a] "+r"(a), [blocks] "+c"(blocks), [hi] "+r"(hi), [lo] "=&r"(lo),
+              [next] "=&r"(next)
+            : "d"(k)
+            : "cc", "memory");
+  }
+  return hi;
+}
+
+// a * k + res fits into n + 1 limbs, so the last high half takes both carries without overflow
+uint64_t x86_addmul_1(uint64_t *res, uint64_t const *a, size_t n, uint64_t k) {
+  uint64_t hi = 0;
+  size_t head = n % 4, blocks = n / 4;
+  for (size_t i = 0; i < head; i++) {
+    uint128_t tmp = static_cast<uint128_t>(a[i]) * k + res[i] + hi;
+    res[i] = static_cast<uint64_t>(tmp);
+    hi = static_cast<uint64_t>(tmp >> 64u);
+  }
+  if (blocks != 0) {
+    uint64_t lo, next;
+    res += head, a += head;
+    __asm__("xor %k[lo], %k[lo]\n\t"
+            "1:\n\t"
+            "mulx (%[a]), %[lo], %[next]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "adox (%[res]), %[lo]\n\t"
+            "mov %[lo], (%[res])\n\t"
+            "mulx 8(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[next], %[lo]\n\t"
+            "adox 8(%[res]), %[lo]\n\t"
+            "mov %[lo], 8(%[res])\n\t"
+            "mulx 16(%[a]), %[lo], %[next]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "adox 16(%[res]), %[lo]\n\t"
+            "mov %[lo], 16(%[res])\n\t"
+            "mulx 24(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[next], %[lo]\n\t"
+            "adox 24(%[res]), %[lo]\n\t"
+            "mov %[lo], 24(%[res])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[res]), %[res]\n\t"
+            "lea -1(%[blocks]), %[blocks]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "mov $0, %k[lo]\n\t"
+            "adcx %[lo], %[hi]\n\t"
+            "adox %[lo], %[hi]"
+            : [res] "+r"(res), [a] "+r"(a), [blocks] "+c"(blocks), [hi] "+r"(hi), [lo] "=&r"(lo),
+              [next] "=&r"(next)
+            : "d"(k)
+            : "cc", "memory");
+  }
+  return hi;
 }
 
-big_integer::big_integer(std::string const &str) {
-  big_integer res;
+// there is no subtracting adox, so the res chain adds the complement: res - t = res + ~t + 1, with OF starting at
+// one (0x7f + 1 overflows a byte and clears CF) and a missing carry out meaning a borrow
+uint64_t x86_submul_1(uint64_t *res, uint64_t const *a, size_t n, uint64_t k) {
+  uint64_t hi = 0;
+  size_t head = n % 4, blocks = n / 4;
+  for (size_t i = 0; i < head; i++) {
+    uint128_t tmp = static_cast<uint128_t>(a[i]) * k + hi;
+    uint64_t low = static_cast<uint64_t>(tmp);
+    hi = static_cast<uint64_t>(tmp >> 64u) + (res[i] < low);
+    res[i] -= low;
+  }
+  if (blocks != 0) {
+    uint64_t lo, next;
+    res += head, a += head;
+    __asm__("mov $127, %k[lo]\n\t"
+            "add $1, %b[lo]\n\t"
+            "1:\n\t"
+            "mulx (%[a]), %[lo], %[next]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "not %[lo]\n\t"
+            "adox (%[res]), %[lo]\n\t"
+            "mov %[lo], (%[res])\n\t"
+            "mulx 8(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[next], %[lo]\n\t"
+            "not %[lo]\n\t"
+            "adox 8(%[res]), %[lo]\n\t"
+            "mov %[lo], 8(%[res])\n\t"
+            "mulx 16(%[a]), %[lo], %[next]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "not %[lo]\n\t"
+            "adox 16(%[res]), %[lo]\n\t"
+            "mov %[lo], 16(%[res])\n\t"
+            "mulx 24(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[next], %[lo]\n\t"
+            "not %[lo]\n\t"
+            "adox 24(%[res]), %[lo]\n\t"
+            "mov %[lo], 24(%[res])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[res]), %[res]\n\t"
+            "lea -1(%[blocks]), %[blocks]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "mov $0, %k[lo]\n\t"
+            "adcx %[lo], %[hi]\n\t"
+            "setno %b[lo]\n\t"
+            "add %[lo], %[hi]"
+            : [res] "+r"(res), [a] "+r"(a), [blocks] "+c"(blocks), [hi] "+r"(hi), [lo] "=&q"(lo),
+              [next] "=&r"(next)
+            : "d"(k)
+            : "cc", "memory");
+  }
+  return hi;
+}
+
+template <>
+struct limb_kernels<uint64_t> {
+  static bool available() {
+    return bmi2_adx;
+  }
+  static uint64_t add_n(uint64_t *res, uint64_t const *a, uint64_t const *b, size_t n) {
+    return x86_add_n(res, a, b, n);
+  }
+  static uint64_t sub_n(uint64_t *res, uint64_t const *a, uint64_t const *b, size_t n) {
+    return x86_sub_n(res, a, b, n);
+  }
+  static uint64_t mul_1(uint64_t *res, uint64_t const *a, size_t n, uint64_t k) {
+    return x86_mul_1(res, a, n, k);
+  }
+  static uint64_t addmul_1(uint64_t *res, uint64_t const *a, size_t n, uint64_t k) {
+    return x86_addmul_1(res, a, n, k);
+  }
+  static uint64_t submul_1(uint64_t *res, uint64_t const *a, size_t n, uint64_t k) {
+    return x86_submul_1(res, a, n, k);
+  }
+};
+#endif
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage>::basic_big_integer() : sign_(false) {
+  data_.resize(1);
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage>::basic_big_integer(int a) : sign_(a < 0) {
+  data_.resize(1);
+  data_[0] = a == INT_MIN ? static_cast<Limb>(INT_MAX) + 1 : static_cast<Limb>(std::abs(a));
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage>::basic_big_integer(std::string const &str) : sign_(false) {
   size_t i = 0;
-  sign_ = false;
+  bool negative = false;
   if (str[0] == '+' || str[0] == '-') {
-    sign_ = str[0] == '-';
+    negative = str[0] == '-';
     i++;
   }
-  for (; i < str.size(); i++) {
-    res = res * 10 + (str[i] - '0');
-  }
-  data_ = res.data_;
+  size_t len = str.size() - i;
+  *this = read_decimal(str.data() + i, len, decimal_powers(decimal_split(len)));
+  sign_ = negative;
   shrink();
 }
 
-bool big_integer::overflow_add(uint32_t a, uint32_t b, bool carry) {
-  return (a > MAX_VALUE - b) || (carry && (a + b == MAX_VALUE));
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::from_limb(Limb x) {
+  basic_big_integer res;
+  res.data_[0] = x;
+  return res;
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::from_double_limb(double_limb x) {
+  basic_big_integer res;
+  res.data_.resize(2);
+  res.data_[0] = static_cast<Limb>(x);
+  res.data_[1] = simple_overflow(x);
+  res.shrink();
+  return res;
+}
+
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::simple_overflow(double_limb x) {
+  return static_cast<Limb>(x >> BASE);
 }
 
-uint32_t big_integer::simple_overflow(uint64_t x) {
-  return uint32_t(x >> BASE);
+template <typename Limb, typename Storage>
+uint32_t basic_big_integer<Limb, Storage>::leading_zeros(Limb x) {
+  return static_cast<uint32_t>(__builtin_clzll(x)) - (64 - BASE);
 }
 
-void big_integer::shrink() {
-  while (data_.size() > 1 && data_.back() == 0) {
-    data_.pop_back();
+// bits of the magnitude, zero for zero
+template <typename Limb, typename Storage>
+size_t basic_big_integer<Limb, Storage>::bit_length() const {
+  Limb top = data_.back();
+  return top == 0 ? 0 : data_.size() * BASE - leading_zeros(top);
+}
+
+// for a value other than zero
+template <typename Limb, typename Storage>
+size_t basic_big_integer<Limb, Storage>::low_zero_bits() const {
+  size_t i = 0;
+  while (data_[i] == 0) {
+    i++;
   }
-  if (data_.size() == 1 && data_.back() == 0) {
+  return i * BASE + static_cast<size_t>(__builtin_ctzll(data_[i]));
+}
+
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::shrink() {
+  // one resize instead of a pop_back, and a copy-on-write check with it, per zero limb
+  basic_big_integer const &self = *this;
+  size_t n = std::max<size_t>(significant(&self.data_[0], data_.size()), 1);
+  if (n != data_.size()) {
+    data_.resize(n);
+  }
+  if (n == 1 && self.data_[0] == 0) {
     sign_ = false;
   }
 }
 
-int big_integer::compare_abs(big_integer const &a, big_integer const &b) {
+template <typename Limb, typename Storage>
+int basic_big_integer<Limb, Storage>::compare_abs(basic_big_integer const &a, basic_big_integer const &b) {
   if (a.data_.size() != b.data_.size()) {
     return a.data_.size() < b.data_.size() ? -1 : 1;
   }
@@ -56,396 +541,2191 @@ int big_integer::compare_abs(big_integer const &a, big_integer const &b) {
   return 0;
 }
 
-big_integer &big_integer::operator+=(big_integer const &rhs) {
-  if (sign_ != rhs.sign_) {
-    return *this = (!sign_ ? (*this - -rhs) : (rhs - (-*this)));
-  }
-  size_t size_l = data_.size(), size_r = rhs.data_.size();
-  size_t size_result = std::max(size_l, size_r);
-  data_.resize(size_result);
-  uint32_t carry = 0;
-  for (size_t i = 0; i < size_result; i++) {
-    uint32_t rhs_digit = i < size_r ? rhs.data_[i] : 0;
-    uint64_t tmp = static_cast<uint64_t>(carry) + data_[i] + rhs_digit;
-    if (overflow_add(data_[i], rhs_digit, carry)) {
-      tmp &= MAX_VALUE;
-      carry = 1;
-    } else {
-      carry = 0;
+template <typename Limb, typename Storage>
+int basic_big_integer<Limb, Storage>::compare(basic_big_integer const &a, basic_big_integer const &b) {
+  if (a.sign_ != b.sign_) {
+    return a.sign_ ? -1 : 1;
+  }
+  return a.sign_ ? compare_abs(b, a) : compare_abs(a, b);
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator+=(basic_big_integer const &rhs) {
+  return add_signed(&rhs.data_[0], rhs.data_.size(), rhs.sign_);
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator-=(basic_big_integer const &rhs) {
+  return add_signed(&rhs.data_[0], rhs.data_.size(), !rhs.sign_);
+}
+
+// adds the magnitude b taken with the sign b_sign: magnitudes are compared at most once and then added or subtracted
+// in place, the kernels tolerate res aliasing either operand, so b may be the limbs of *this; storage grows only when
+// the result needs more limbs
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::add_signed(Limb const *b, size_t m, bool b_sign) {
+  basic_big_integer const &self = *this;
+  size_t n = data_.size();
+  if (sign_ == b_sign) {
+    if (n < m) {
+      data_.resize(m);
     }
-    data_[i] = tmp;
+    Limb *a = &data_[0];
+    Limb carry = n >= m ? add_limbs(a, a, n, b, m) : add_limbs(a, b, m, a, n);
+    if (carry != 0) {
+      data_.push_back(carry);
+    }
+  } else if (compare_limbs(&self.data_[0], n, b, m) >= 0) {
+    Limb *a = &data_[0];
+    sub_limbs(a, a, n, b, m);
+  } else {
+    data_.resize(m);
+    Limb *a = &data_[0];
+    sub_limbs(a, b, m, a, n);
+    sign_ = b_sign;
   }
-  data_.push_back(carry);
   shrink();
   return *this;
 }
 
-big_integer &big_integer::operator-=(big_integer const &rhs) {
-  if (sign_ != rhs.sign_) {
-    return *this = (!sign_ ? *this + (-rhs) : -(-*this + rhs));
-  } else if (sign_) {
-    return *this = (-rhs - (-*this));
+template <typename Limb, typename Storage>
+size_t basic_big_integer<Limb, Storage>::significant(Limb const *a, size_t n) {
+  while (n > 0 && a[n - 1] == 0) {
+    n--;
   }
-  if (*this < rhs) {
-    return *this = -(rhs - *this);
+  return n;
+}
+
+template <typename Limb, typename Storage>
+int basic_big_integer<Limb, Storage>::compare_limbs(Limb const *a, size_t n, Limb const *b, size_t m) {
+  n = significant(a, n);
+  m = significant(b, m);
+  if (n != m) {
+    return n < m ? -1 : 1;
   }
-  uint32_t carry = 0;
-  for (size_t i = 0; i < rhs.data_.size() || carry; i++) {
-    int64_t tmp;
-    uint32_t rhs_digit = i < rhs.data_.size() ? rhs.data_[i] : 0;
-    tmp = static_cast<int64_t>(data_[i]) - carry - rhs_digit;
-    carry = 0;
-    if (tmp < 0) {
-      carry = 1;
-      tmp += FULL_DIGIT;
+  for (size_t i = n; i > 0; i--) {
+    if (a[i - 1] != b[i - 1]) {
+      return a[i - 1] < b[i - 1] ? -1 : 1;
     }
-    data_[i] = tmp;
   }
-  shrink();
-  return *this;
+  return 0;
 }
 
-big_integer &big_integer::operator*=(big_integer const &rhs) {
-  big_integer res;
-  size_t size_1 = data_.size(),
-      size_2 = rhs.data_.size(),
-      size_result = size_1 + size_2 + 1;
-  res.data_.resize(size_result, 0);
-  for (size_t i = 0; i < size_1; i++) {
-    uint64_t carry = 0;
-    for (size_t j = 0; j < size_2 || carry; j++) {
-      uint64_t tmp;
-      uint32_t rhs_digit = j < rhs.data_.size() ? rhs.data_[j] : 0;
-      uint32_t data_digit = i < data_.size() ? data_[i] : 0;
-      tmp = res.data_[i + j] + static_cast<uint64_t>(data_digit) * rhs_digit + carry;
-      res.data_[i + j] = tmp & MAX_VALUE;
-      carry = simple_overflow(tmp);
-    }
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::add_limbs(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m) {
+  double_limb carry = 0;
+  size_t i = 0;
+  if (limb_kernels<Limb>::available()) {
+    carry = limb_kernels<Limb>::add_n(res, a, b, m);
+    i = m;
   }
-  res.sign_ = (rhs.sign_ != sign_);
-  res.shrink();
-  return *this = res;
+  for (; i < m; i++) {
+    carry += static_cast<double_limb>(a[i]) + b[i];
+    res[i] = static_cast<Limb>(carry);
+    carry >>= BASE;
+  }
+  for (; i < n; i++) {
+    carry += a[i];
+    res[i] = static_cast<Limb>(carry);
+    carry >>= BASE;
+  }
+  return static_cast<Limb>(carry);
+}
+
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::sub_limbs(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m) {
+  Limb borrow = 0;
+  size_t i = 0;
+  if (limb_kernels<Limb>::available()) {
+    borrow = limb_kernels<Limb>::sub_n(res, a, b, m);
+    i = m;
+  }
+  for (; i < m; i++) {
+    double_limb tmp = static_cast<double_limb>(a[i]) - b[i] - borrow;
+    res[i] = static_cast<Limb>(tmp);
+    borrow = static_cast<Limb>(tmp >> BASE) & 1u;
+  }
+  for (; i < n; i++) {
+    double_limb tmp = static_cast<double_limb>(a[i]) - borrow;
+    res[i] = static_cast<Limb>(tmp);
+    borrow = static_cast<Limb>(tmp >> BASE) & 1u;
+  }
+  return borrow;
 }
 
-big_integer big_integer::product(big_integer y, uint32_t k) {
-  uint32_t carry = 0;
-  for (unsigned int &i : y.data_) {
-    uint64_t tmp = static_cast<uint64_t>(i) * k + carry;
-    i = tmp & MAX_VALUE;
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::addmul_1(Limb *res, Limb const *a, size_t n, Limb k) {
+  if (limb_kernels<Limb>::available()) {
+    return limb_kernels<Limb>::addmul_1(res, a, n, k);
+  }
+  double_limb carry = 0;
+  for (size_t i = 0; i < n; i++) {
+    double_limb tmp = res[i] + static_cast<double_limb>(a[i]) * k + carry;
+    res[i] = static_cast<Limb>(tmp);
     carry = simple_overflow(tmp);
   }
-  y.data_.push_back(carry);
-  y.shrink();
-  return y;
+  return static_cast<Limb>(carry);
 }
 
-/*
-big_integer big_integer::product(big_integer y, uint32_t k) {
-  uint64_t carry = 0;
-  for (unsigned int &i : y.data_) {
-    carry += static_cast<uint64_t>(i) * k;
-    i = carry & MAX_VALUE;
-    carry >>= BASE;
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::mul_1(Limb *res, Limb const *a, size_t n, Limb k) {
+  if (limb_kernels<Limb>::available()) {
+    return limb_kernels<Limb>::mul_1(res, a, n, k);
   }
-  y.data_.push_back(static_cast<uint32_t>(carry));
-  y.shrink();
-  return y;
+  double_limb carry = 0;
+  for (size_t i = 0; i < n; i++) {
+    double_limb tmp = static_cast<double_limb>(a[i]) * k + carry;
+    res[i] = static_cast<Limb>(tmp);
+    carry = simple_overflow(tmp);
+  }
+  return static_cast<Limb>(carry);
 }
-*/
 
-big_integer big_integer::quotient(big_integer y, uint32_t k) {
-  uint64_t carry = 0;
-  for (size_t i = y.data_.size(); i > 0; i--) {
-    uint64_t tmp = (carry << BASE) + y.data_[i - 1];
-    y.data_[i - 1] = tmp / k;
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::div_1(Limb *res, Limb const *a, size_t n, Limb k) {
+  double_limb carry = 0;
+  for (size_t i = n; i > 0; i--) {
+    double_limb tmp = (carry << BASE) + a[i - 1];
+    res[i - 1] = static_cast<Limb>(tmp / k);
     carry = tmp % k;
   }
-  y.shrink();
-  return y;
+  return static_cast<Limb>(carry);
 }
 
-uint32_t big_integer::remainder(big_integer y, uint32_t k) {
-  uint64_t carry = 0;
-  for (size_t i = y.data_.size(); i > 0; i--) {
-    carry = ((carry << BASE) + y.data_[i - 1]) % k;
+// 0 < shift < BASE
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::shr_limbs(Limb *res, Limb const *a, size_t n, uint32_t shift) {
+  for (size_t i = 0; i + 1 < n; i++) {
+    res[i] = (a[i] >> shift) | (a[i + 1] << (BASE - shift));
   }
-  return carry;
+  res[n - 1] = a[n - 1] >> shift;
 }
 
-uint32_t big_integer::trial(uint64_t a, uint64_t b, uint64_t c) {
-  return std::min(((a << BASE) + b) / c, static_cast<uint64_t>(MAX_VALUE));
+// 0 < shift < BASE, returns the bits shifted out of the top limb
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::shl_limbs(Limb *res, Limb const *a, size_t n, uint32_t shift) {
+  Limb out = a[n - 1] >> (BASE - shift);
+  for (size_t i = n - 1; i > 0; i--) {
+    res[i] = (a[i] << shift) | (a[i - 1] >> (BASE - shift));
+  }
+  res[0] = a[0] << shift;
+  return out;
 }
 
-bool big_integer::smaller(big_integer &r, big_integer &dq, uint32_t k, uint32_t m) {
-  for (size_t i = m; i > 0; i--) {
-    uint32_t dq_digit = i < dq.data_.size() ? dq.data_[i] : 0;
-    if (r.data_[i - 1 + k] != dq_digit) {
-      return r.data_[i - 1 + k] < dq_digit;
-    }
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::mul_basecase(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m) {
+  if (n == 0) {
+    std::fill(res, res + m, 0);
+    return;
+  }
+  res[m] = mul_1(res, b, m, a[0]);
+  for (size_t i = 1; i < n; i++) {
+    res[i + m] = addmul_1(res + i, b, m, a[i]);
   }
-  return false;
 }
 
-void big_integer::difference(big_integer &r, big_integer &dq, uint32_t k, uint32_t m) {
-  uint32_t borrow = 0;
-  for (size_t i = 0; i < m; i++) {
-    uint32_t dq_digit = i < dq.data_.size() ? dq.data_[i] : 0;
-    int64_t diff = static_cast<int64_t>(r.data_[i + k - 1]) - dq_digit - borrow;
-    borrow = 0;
-    if (diff < 0) {
-      borrow = 1;
-      diff += FULL_DIGIT;
-    }
-    r.data_[i + k - 1] = diff;
-  }
-}
-
-big_integer &big_integer::operator/=(big_integer const &rhs) {
-  int comparing = compare_abs(*this, rhs);
-  if (comparing == -1) {
-    return *this = 0;
-  }
-  sign_ = (rhs.sign_ != sign_);
-  if (rhs.data_.size() == 1) {
-    return *this = quotient(*this, rhs.data_[0]);
-  }
-  uint32_t f = FULL_DIGIT / (rhs.data_.back() + 1);
-  big_integer r, d;
-  r = product(*this, f);
-  r.data_.push_back(0);
-  d = product(rhs, f);
-  size_t n = r.data_.size(), m = d.data_.size();
-  data_.resize(n - m);
-  big_integer dq;
-  for (size_t k = n - m; k > 0; k--) {
-    uint32_t qt = trial(r.data_[k + m - 1], r.data_[k + m - 2], d.data_[m - 1]);
-    dq = product(d, qt);
-    while (smaller(r, dq, k, m)) {
-      qt--;
-      dq -= d;
-    }
-    data_[k - 1] = qt;
-    difference(r, dq, k, m);
+// n >= 2m: cut a into m-limb slices, so each partial product is balanced
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::mul_unbalanced(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m) {
+  std::fill(res, res + n + m, 0);
+  std::vector<Limb> part(2 * m);
+  for (size_t offset = 0; offset < n; offset += m) {
+    size_t len = std::min(m, n - offset);
+    mul_limbs(part.data(), a + offset, len, b, m);
+    add_limbs(res + offset, res + offset, n + m - offset, part.data(), len + m);
   }
-  shrink();
-  return *this;
 }
 
-big_integer &big_integer::operator%=(big_integer const &rhs) {
-  return *this -= (*this / rhs) * rhs;
-}
+// m <= n < 2m: a * b = z2 X^2 + ((a0 + a1)(b0 + b1) - z0 - z2) X + z0, X = BASE^(n / 2)
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::mul_karatsuba(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m) {
+  size_t h = n / 2;
+  Limb const *a1 = a + h, *b1 = b + h;
+  size_t n1 = n - h, m1 = m - h;
 
-big_integer big_integer::to_complementary(big_integer const &a) {
-  if (!a.sign_) {
-    return a;
+  mul_limbs(res, a, h, b, h);
+  mul_limbs(res + 2 * h, a1, n1, b1, m1);
+
+  std::vector<Limb> sa(n1 + 1), sb(std::max(h, m1) + 1);
+  sa[n1] = add_limbs(sa.data(), a1, n1, a, h);
+  if (m1 >= h) {
+    sb[m1] = add_limbs(sb.data(), b1, m1, b, h);
+  } else {
+    sb[h] = add_limbs(sb.data(), b, h, b1, m1);
   }
-  big_integer res(a);
-  res.sign_ = false;
-  for (unsigned int &i : res.data_) {
-    i = ~i;
+
+  std::vector<Limb> mid(sa.size() + sb.size());
+  mul_limbs(mid.data(), sa.data(), sa.size(), sb.data(), sb.size());
+  sub_limbs(mid.data(), mid.data(), mid.size(), res, 2 * h);
+  sub_limbs(mid.data(), mid.data(), mid.size(), res + 2 * h, n1 + m1);
+
+  size_t mid_size = mid.size();
+  while (mid_size > 0 && mid[mid_size - 1] == 0) {
+    mid_size--;
   }
-  res += 1;
-  return res;
+  add_limbs(res + h, res + h, n + m - h, mid.data(), mid_size);
+}
+
+// a(1), |a(-1)| and a(2) of a0 + a1 X + a2 X^2; returns whether a(-1) is negative
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::toom3_evaluate(Limb const *a, size_t k, size_t n2, Limb *e1, Limb *em1,
+                                                      Limb *e2) {
+  Limb const *a1 = a + k, *a2 = a + 2 * k;
+  e1[k] = add_limbs(e1, a, k, a2, n2);
+  bool negative = compare_limbs(e1, k + 1, a1, k) < 0;
+  if (negative) {
+    sub_limbs(em1, a1, k, e1, k);
+    em1[k] = 0;
+  } else {
+    em1[k] = e1[k] - sub_limbs(em1, e1, k, a1, k);
+  }
+  e1[k] += add_limbs(e1, e1, k, a1, k);
+
+  std::copy(a, a + k, e2);
+  e2[k] = addmul_1(e2, a1, k, 2);
+  Limb carry = addmul_1(e2, a2, n2, 4);
+  add_limbs(e2 + n2, e2 + n2, k + 1 - n2, &carry, 1);
+  return negative;
 }
 
-big_integer &big_integer::bitwise(big_integer const &rhs,
-                                  const std::function<uint32_t(uint32_t, uint32_t)> &f) {
-  big_integer left = to_complementary(*this),
-      right = to_complementary(rhs);
-  size_t new_size = std::max(left.data_.size(), right.data_.size());
-  big_integer res;
-  res.data_.resize(new_size);
+// m <= n < 2m, m > 2k: evaluate at 0, 1, -1, 2, inf and interpolate, X = BASE^k, k = ceil(n / 3)
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::mul_toom3(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m) {
+  size_t k = (n + 2) / 3, n2 = n - 2 * k, m2 = m - 2 * k;
+  size_t s = k + 1, p = 2 * s;
+  std::vector<Limb> buf(6 * s + 3 * p);
+  Limb *a_1 = buf.data(), *a_m1 = a_1 + s, *a_2 = a_m1 + s;
+  Limb *b_1 = a_2 + s, *b_m1 = b_1 + s, *b_2 = b_m1 + s;
+  Limb *v1 = b_2 + s, *vm1 = v1 + p, *v2 = vm1 + p;
+  bool negative = toom3_evaluate(a, k, n2, a_1, a_m1, a_2) != toom3_evaluate(b, k, m2, b_1, b_m1, b_2);
 
-  uint32_t addition_1 = sign_ ? MAX_VALUE : 0,
-            addition_2 = rhs.sign_ ? MAX_VALUE : 0;
-  for (size_t i = 0; i < new_size; i++) {
-    uint32_t left_digit = i < left.data_.size() ? left.data_[i] : addition_1;
-    uint32_t right_digit = i < right.data_.size() ? right.data_[i] : addition_2;
-    res.data_[i] = f(left_digit, right_digit);
+  mul_limbs(v1, a_1, s, b_1, s);
+  mul_limbs(vm1, a_m1, s, b_m1, s);
+  mul_limbs(v2, a_2, s, b_2, s);
+  mul_limbs(res, a, k, b, k);
+  mul_limbs(res + 4 * k, a + 2 * k, n2, b + 2 * k, m2);
+  toom3_interpolate(res, n + m, k, v1, vm1, v2, negative);
+}
+
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::sqr_toom3(Limb *res, Limb const *a, size_t n) {
+  size_t k = (n + 2) / 3, n2 = n - 2 * k;
+  size_t s = k + 1, p = 2 * s;
+  std::vector<Limb> buf(3 * s + 3 * p);
+  Limb *a_1 = buf.data(), *a_m1 = a_1 + s, *a_2 = a_m1 + s;
+  Limb *v1 = a_2 + s, *vm1 = v1 + p, *v2 = vm1 + p;
+  toom3_evaluate(a, k, n2, a_1, a_m1, a_2);
+
+  sqr_limbs(v1, a_1, s);
+  sqr_limbs(vm1, a_m1, s);
+  sqr_limbs(v2, a_2, s);
+  sqr_limbs(res, a, k);
+  sqr_limbs(res + 4 * k, a + 2 * k, n2);
+  toom3_interpolate(res, 2 * n, k, v1, vm1, v2, false);
+}
+
+// res holds v0 in [0, 2k) and vinf in [4k, size); v1, vm1 and v2 are 2k + 2 limbs long and get clobbered
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::toom3_interpolate(Limb *res, size_t size, size_t k, Limb *v1, Limb *vm1,
+                                                         Limb *v2, bool negative) {
+  size_t p = 2 * k + 2;
+  Limb *v0 = res, *vinf = res + 4 * k;
+  size_t vinf_size = size - 4 * k;
+  std::fill(res + 2 * k, res + 4 * k, 0);
+
+  // result = c0 + c1 X + c2 X^2 + c3 X^3 + c4 X^4, c0 = v0, c4 = vinf
+  if (negative) {
+    add_limbs(v2, v2, p, vm1, p);
+    add_limbs(vm1, v1, p, vm1, p);
+  } else {
+    sub_limbs(v2, v2, p, vm1, p);
+    sub_limbs(vm1, v1, p, vm1, p);
   }
-  res.sign_ = f(sign_, rhs.sign_);
-  res.shrink();
-  if (res.sign_) {
-    res = to_complementary(res);
-    res.sign_ = f(sign_, rhs.sign_);
+  div_1(v2, v2, p, 3);
+  shr_limbs(vm1, vm1, p, 1);
+  sub_limbs(v1, v1, p, v0, 2 * k);
+  sub_limbs(v2, v2, p, v1, p);
+  shr_limbs(v2, v2, p, 1);
+  sub_limbs(v1, v1, p, vm1, p);
+  sub_limbs(v1, v1, p, vinf, vinf_size);
+  sub_limbs(v2, v2, p, vinf, vinf_size);
+  sub_limbs(v2, v2, p, vinf, vinf_size);
+  sub_limbs(vm1, vm1, p, v2, p);
+
+  add_limbs(res + k, res + k, size - k, vm1, significant(vm1, p));
+  add_limbs(res + 2 * k, res + 2 * k, size - 2 * k, v1, significant(v1, p));
+  add_limbs(res + 3 * k, res + 3 * k, size - 3 * k, v2, significant(v2, p));
+}
+
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::mul_limbs(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+  if (m < KARATSUBA_THRESHOLD) {
+    mul_basecase(res, a, n, b, m);
+  } else if (m >= NTT_THRESHOLD && n + m <= NTT_MAX_SIZE) {
+    ntt_multiply(res, a, n, b, m);
+  } else if (n >= 2 * m) {
+    mul_unbalanced(res, a, n, b, m);
+  } else if (m < TOOM3_THRESHOLD || m <= 2 * ((n + 2) / 3)) {
+    mul_karatsuba(res, a, n, b, m);
+  } else {
+    mul_toom3(res, a, n, b, m);
   }
-  res.shrink();
-  return *this = res;
 }
 
-big_integer &big_integer::operator&=(big_integer const &rhs) {
-  return bitwise(rhs, [](uint32_t a, uint32_t b) { return a & b; });
+// cross products a[i] * a[j], i < j, are computed once and doubled, then the diagonal is added
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::sqr_basecase(Limb *res, Limb const *a, size_t n) {
+  std::fill(res, res + 2 * n, 0);
+  for (size_t i = 0; i < n; i++) {
+    res[i + n] = addmul_1(res + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+  }
+  shl_limbs(res, res, 2 * n, 1);
+  double_limb carry = 0;
+  for (size_t i = 0; i < n; i++) {
+    double_limb square = static_cast<double_limb>(a[i]) * a[i];
+    carry += static_cast<double_limb>(res[2 * i]) + static_cast<Limb>(square);
+    res[2 * i] = static_cast<Limb>(carry);
+    carry >>= BASE;
+    carry += static_cast<double_limb>(res[2 * i + 1]) + simple_overflow(square);
+    res[2 * i + 1] = static_cast<Limb>(carry);
+    carry >>= BASE;
+  }
 }
 
-big_integer &big_integer::operator|=(big_integer const &rhs) {
-  return bitwise(rhs, [](uint32_t a, uint32_t b) { return a | b; });
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::sqr_karatsuba(Limb *res, Limb const *a, size_t n) {
+  size_t h = n / 2, n1 = n - h;
+  sqr_limbs(res, a, h);
+  sqr_limbs(res + 2 * h, a + h, n1);
+
+  std::vector<Limb> sa(n1 + 1), mid(2 * n1 + 2);
+  sa[n1] = add_limbs(sa.data(), a + h, n1, a, h);
+  sqr_limbs(mid.data(), sa.data(), sa.size());
+  sub_limbs(mid.data(), mid.data(), mid.size(), res, 2 * h);
+  sub_limbs(mid.data(), mid.data(), mid.size(), res + 2 * h, 2 * n1);
+  add_limbs(res + h, res + h, 2 * n - h, mid.data(), significant(mid.data(), mid.size()));
 }
 
-big_integer &big_integer::operator^=(big_integer const &rhs) {
-  return bitwise(rhs, [](uint32_t a, uint32_t b) { return a ^ b; });
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::sqr_limbs(Limb *res, Limb const *a, size_t n) {
+  if (n < KARATSUBA_THRESHOLD) {
+    sqr_basecase(res, a, n);
+  } else if (n >= NTT_THRESHOLD && 2 * n <= NTT_MAX_SIZE) {
+    ntt_multiply(res, a, n, a, n);
+  } else if (n < TOOM3_THRESHOLD) {
+    sqr_karatsuba(res, a, n);
+  } else {
+    sqr_toom3(res, a, n);
+  }
 }
 
-big_integer &big_integer::operator<<=(int rhs) {
-  uint32_t limbs_cnt = rhs / BASE;
-  uint32_t digit_cnt = rhs % BASE;
-  uint32_t mod = 1u << digit_cnt;
-  big_integer shifted = *this * mod;
-  size_t new_size = shifted.data_.size() + limbs_cnt;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator*=(basic_big_integer const &rhs) {
+  basic_big_integer res;
+  basic_big_integer const &lhs = *this;
+  size_t size_1 = data_.size(),
+      size_2 = rhs.data_.size();
+  res.data_.resize(size_1 + size_2);
+  if (&lhs.data_[0] == &rhs.data_[0] || compare_abs(lhs, rhs) == 0) {
+    sqr_limbs(&res.data_[0], &lhs.data_[0], size_1);
+  } else {
+    mul_limbs(&res.data_[0], &lhs.data_[0], size_1, &rhs.data_[0], size_2);
+  }
+  res.sign_ = (rhs.sign_ != sign_);
+  res.shrink();
+  return *this = std::move(res);
+}
 
-  data_.resize(new_size);
-  for (size_t i = 0; i < limbs_cnt; ++i) {
-    data_[i] = 0;
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::submul_1(Limb *res, Limb const *a, size_t n, Limb k) {
+  if (limb_kernels<Limb>::available()) {
+    return limb_kernels<Limb>::submul_1(res, a, n, k);
   }
-  for (size_t i = 0; i < shifted.data_.size(); i++) {
-    data_[i + limbs_cnt] = shifted.data_[i];
+  Limb borrow = 0;
+  for (size_t i = 0; i < n; i++) {
+    double_limb tmp = static_cast<double_limb>(a[i]) * k + borrow;
+    Limb low = static_cast<Limb>(tmp);
+    borrow = simple_overflow(tmp) + (res[i] < low);
+    res[i] -= low;
   }
-  shrink();
-  return *this;
+  return borrow;
 }
 
-big_integer &big_integer::operator>>=(int rhs) {
-  uint32_t limbs_cnt = rhs / BASE;
-  uint32_t digit_cnt = rhs % BASE;
-  uint32_t mod = 1u << digit_cnt;
-  big_integer shifted = *this / mod;
-  size_t new_size = shifted.data_.size() - limbs_cnt;
-
-  if (new_size <= 0) {
-    return *this = ZERO;
+// res[0, size) += a * b, size >= n + m: below the karatsuba threshold the rows a * b[j] go straight into res, above
+// it a subquadratic product is worth its buffer; returns the carry out of res[size - 1]
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::addmul_limbs(Limb *res, size_t size, Limb const *a, size_t n, Limb const *b,
+                                                    size_t m) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
   }
-  data_.resize(new_size);
-  for (size_t i = 0; i < new_size; i++) {
-    data_[i] = shifted.data_[i + limbs_cnt];
+  if (m >= KARATSUBA_THRESHOLD) {
+    std::vector<Limb> prod(n + m);
+    if (a == b && n == m) {
+      sqr_limbs(prod.data(), a, n);
+    } else {
+      mul_limbs(prod.data(), a, n, b, m);
+    }
+    return add_limbs(res, res, size, prod.data(), n + m);
   }
-  if (sign_) {
-    *this -= 1;
+  Limb carry = 0;
+  for (size_t j = 0; j < m; j++) {
+    Limb top = addmul_1(res + j, a, n, b[j]);
+    for (size_t i = j + n; top != 0 && i < size; i++) {
+      res[i] += top;
+      top = res[i] < top;
+    }
+    carry += top;
   }
-  shrink();
-  return *this;
+  return carry;
 }
 
-big_integer big_integer::operator+() const {
-  return *this;
+// res[0, size) -= a * b like addmul_limbs, returns the borrow out of res[size - 1]
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::submul_limbs(Limb *res, size_t size, Limb const *a, size_t n, Limb const *b,
+                                                    size_t m) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+  if (m >= KARATSUBA_THRESHOLD) {
+    std::vector<Limb> prod(n + m);
+    if (a == b && n == m) {
+      sqr_limbs(prod.data(), a, n);
+    } else {
+      mul_limbs(prod.data(), a, n, b, m);
+    }
+    return sub_limbs(res, res, size, prod.data(), n + m);
+  }
+  Limb borrow = 0;
+  for (size_t j = 0; j < m; j++) {
+    Limb low = submul_1(res + j, a, n, b[j]);
+    for (size_t i = j + n; low != 0 && i < size; i++) {
+      Limb old = res[i];
+      res[i] -= low;
+      low = old < low;
+    }
+    borrow += low;
+  }
+  return borrow;
 }
 
-big_integer big_integer::operator-() const {
-  big_integer tmp(*this);
-  if (tmp != ZERO) {
-    tmp.sign_ = !sign_;
+// res[0, size) += a << shift, shift < BASE, size > n; the shifted limbs are formed as they are added
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::addshl_limbs(Limb *res, size_t size, Limb const *a, size_t n, uint32_t shift) {
+  Limb prev = 0;
+  double_limb carry = 0;
+  for (size_t i = 0; i < size && (i <= n || carry != 0); i++) {
+    Limb cur = i < n ? a[i] : 0;
+    carry += static_cast<double_limb>(res[i]) + (shift == 0 ? cur : (cur << shift) | (prev >> (BASE - shift)));
+    res[i] = static_cast<Limb>(carry);
+    carry >>= BASE;
+    prev = cur;
   }
-  return tmp;
+  return static_cast<Limb>(carry);
 }
 
-big_integer big_integer::operator~() const {
-  return -*this - 1;
+// res[0, size) -= a << shift like addshl_limbs, returns the borrow out of res[size - 1]
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::subshl_limbs(Limb *res, size_t size, Limb const *a, size_t n, uint32_t shift) {
+  Limb prev = 0;
+  Limb borrow = 0;
+  for (size_t i = 0; i < size && (i <= n || borrow != 0); i++) {
+    Limb cur = i < n ? a[i] : 0;
+    double_limb tmp = static_cast<double_limb>(res[i]) - borrow -
+                      (shift == 0 ? cur : (cur << shift) | (prev >> (BASE - shift)));
+    res[i] = static_cast<Limb>(tmp);
+    borrow = static_cast<Limb>(tmp >> BASE) & 1u;
+    prev = cur;
+  }
+  return borrow;
 }
 
-big_integer &big_integer::operator++() {
-  return *this += 1;
+// Knuth's algorithm D on normalized d, m >= 2: a[m, n) / d goes to q (n - m limbs plus the returned top one),
+// the remainder is left in a[0, m)
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::div_basecase(Limb *q, Limb *a, size_t n, Limb const *d, size_t m) {
+  Limb qh = compare_limbs(a + n - m, m, d, m) >= 0;
+  if (qh) {
+    sub_limbs(a + n - m, a + n - m, m, d, m);
+  }
+  double_limb d1 = d[m - 1], d2 = d[m - 2];
+  for (size_t j = n - m; j > 0; j--) {
+    Limb *r = a + j - 1;
+    double_limb top = (static_cast<double_limb>(r[m]) << BASE) | r[m - 1];
+    double_limb qt = r[m] >= d1 ? MAX_VALUE : top / d1;
+    double_limb rt = top - qt * d1;
+    while ((rt >> BASE) == 0 && qt * d2 > ((rt << BASE) | r[m - 2])) {
+      qt--;
+      rt += d1;
+    }
+    Limb high = r[m];
+    Limb borrow = submul_1(r, d, m, static_cast<Limb>(qt));
+    r[m] = high - borrow;
+    if (high < borrow) {
+      qt--;
+      r[m] += add_limbs(r, r, m, d, m);
+    }
+    q[j - 1] = static_cast<Limb>(qt);
+  }
+  return qh;
 }
 
-big_integer big_integer::operator++(int) {
-  big_integer r = *this;
-  ++*this;
-  return r;
+// Burnikel-Ziegler step: 2m limbs of a by m limbs of normalized d, q gets m limbs plus the returned top one
+template <typename Limb, typename Storage>
+Limb basic_big_integer<Limb, Storage>::div_dc_n(Limb *q, Limb *a, Limb const *d, size_t m) {
+  if (m < DIV_DC_THRESHOLD) {
+    return div_basecase(q, a, 2 * m, d, m);
+  }
+  size_t lo = m / 2, hi = m - lo;
+  Limb const one = 1;
+  std::vector<Limb> tmp(m);
+
+  Limb qh = div_dc_n(q + lo, a + 2 * lo, d + lo, hi);
+  mul_limbs(tmp.data(), q + lo, hi, d, lo);
+  Limb carry = sub_limbs(a + lo, a + lo, m, tmp.data(), m);
+  if (qh) {
+    carry += sub_limbs(a + m, a + m, lo, d, lo);
+  }
+  while (carry != 0) {
+    qh -= sub_limbs(q + lo, q + lo, hi, &one, 1);
+    carry -= add_limbs(a + lo, a + lo, m, d, m);
+  }
+
+  Limb ql = div_dc_n(q, a + hi, d + hi, lo);
+  mul_limbs(tmp.data(), d, hi, q, lo);
+  carry = sub_limbs(a, a, m, tmp.data(), m);
+  if (ql) {
+    carry += sub_limbs(a + lo, a + lo, hi, d, hi);
+  }
+  while (carry != 0) {
+    sub_limbs(q, q, lo, &one, 1);
+    carry -= add_limbs(a, a, m, d, m);
+  }
+  return qh;
 }
 
-big_integer &big_integer::operator--() {
-  return *this -= 1;
+// a[n - m, n) < d, d normalized: q gets n - m limbs, the remainder is left in a[0, m)
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::div_limbs(Limb *q, Limb *a, size_t n, Limb const *d, size_t m) {
+  size_t qn = n - m;
+  if (qn < DIV_DC_THRESHOLD || m < DIV_DC_THRESHOLD) {
+    div_basecase(q, a, n, d, m);
+    return;
+  }
+  if (qn < m) {
+    // the top 2qn limbs divided by the top qn limbs of d overestimate the quotient by a few units at most
+    Limb const *d_high = d + m - qn;
+    Limb *a_high = a + n - 2 * qn;
+    Limb qh = compare_limbs(a_high + qn, qn, d_high, qn) >= 0;
+    if (qh) {
+      sub_limbs(a_high + qn, a_high + qn, qn, d_high, qn);
+    }
+    qh += div_dc_n(q, a_high, d_high, qn);
+
+    Limb const one = 1;
+    std::vector<Limb> tmp(m);
+    mul_limbs(tmp.data(), q, qn, d, m - qn);
+    Limb carry = sub_limbs(a, a, m, tmp.data(), m);
+    if (qh) {
+      carry += sub_limbs(a + qn, a + qn, m - qn, d, m - qn);
+    }
+    while (carry != 0) {
+      qh -= sub_limbs(q, q, qn, &one, 1);
+      carry -= add_limbs(a, a, m, d, m);
+    }
+    return;
+  }
+  size_t first = qn % m;
+  if (first != 0) {
+    div_limbs(q + qn - first, a + qn - first, m + first, d, m);
+  }
+  for (size_t j = qn - first; j > 0; j -= m) {
+    div_dc_n(q + j - m, a + j - m, d, m);
+  }
 }
 
-big_integer big_integer::operator--(int) {
-  big_integer r = *this;
-  --*this;
-  return r;
+// building the inverse costs about two divisions, so it only pays off on long dividends
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::use_reciprocal(basic_big_integer const &a, basic_big_integer const &b) {
+  return b.data_.size() >= NEWTON_THRESHOLD && a.data_.size() >= 4 * b.data_.size();
 }
 
-big_integer operator+(big_integer a, big_integer const &b) {
-  return a += b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator/=(basic_big_integer const &rhs) {
+  return *this = divide(*this, rhs).first;
 }
 
-big_integer operator-(big_integer a, big_integer const &b) {
-  return a -= b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator%=(basic_big_integer const &rhs) {
+  return *this = divide(*this, rhs).second;
 }
 
-big_integer operator*(big_integer a, big_integer const &b) {
-  return a *= b;
+// works on two's complement limbs in place, a single pass over max(n, m) + 1 limbs: a negative magnitude m is read
+// as ~(m - 1), the borrow of m - 1 only runs through the low zero limbs, and a negative result r is turned back into
+// the magnitude ~r + 1
+template <typename Limb, typename Storage>
+template <typename Op>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::bitwise(basic_big_integer const &rhs, Op op) {
+  if (this == &rhs) {
+    return bitwise(basic_big_integer(rhs), op);
+  }
+  size_t n = data_.size(), m = rhs.data_.size(), size = std::max(n, m) + 1;
+  Limb mask_a = sign_ ? MAX_VALUE : 0;
+  Limb mask_b = rhs.sign_ ? MAX_VALUE : 0;
+  Limb mask_r = op(mask_a, mask_b);
+  data_.resize(size);
+  Limb *a = &data_[0];
+  Limb const *b = &rhs.data_[0];
+  if (sign_) {
+    for (size_t i = 0; a[i]-- == 0; i++) {
+    }
+  }
+  size_t i = 0;
+  if (rhs.sign_) {
+    for (; b[i] == 0; i++) {
+      a[i] = op(a[i] ^ mask_a, 0) ^ mask_r;
+    }
+    a[i] = op(a[i] ^ mask_a, (b[i] - 1) ^ mask_b) ^ mask_r;
+    i++;
+  }
+  for (; i < m; i++) {
+    a[i] = op(a[i] ^ mask_a, b[i] ^ mask_b) ^ mask_r;
+  }
+  for (; i < size; i++) {
+    a[i] = op(a[i] ^ mask_a, mask_b) ^ mask_r;
+  }
+  if (mask_r != 0) {
+    for (i = 0; ++a[i] == 0; i++) {
+    }
+  }
+  sign_ = mask_r != 0;
+  shrink();
+  return *this;
 }
 
-big_integer operator/(big_integer a, big_integer const &b) {
-  return a /= b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator&=(basic_big_integer const &rhs) {
+  return bitwise(rhs, [](Limb a, Limb b) { return a & b; });
 }
 
-big_integer operator%(big_integer a, big_integer const &b) {
-  return a %= b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator|=(basic_big_integer const &rhs) {
+  return bitwise(rhs, [](Limb a, Limb b) { return a | b; });
 }
 
-big_integer operator&(big_integer a, big_integer const &b) {
-  return a &= b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator^=(basic_big_integer const &rhs) {
+  return bitwise(rhs, [](Limb a, Limb b) { return a ^ b; });
 }
 
-big_integer operator|(big_integer a, big_integer const &b) {
-  return a |= b;
+// kernel(res, size, subtract) adds or subtracts a magnitude in the limbs of *this widened to size, with one spare top
+// limb; a borrow out of it means that the result went below zero and is left in two's complement, so it is negated
+template <typename Limb, typename Storage>
+template <typename Kernel>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::accumulate(size_t size, bool rhs_sign,
+                                                                              Kernel kernel) {
+  size = std::max(size, data_.size()) + 1;
+  data_.resize(size);
+  Limb *r = &data_[0];
+  if (sign_ == rhs_sign) {
+    kernel(r, size, false);
+  } else if (kernel(r, size, true) != 0) {
+    for (size_t i = 0; i < size; i++) {
+      r[i] = ~r[i];
+    }
+    for (size_t i = 0; ++r[i] == 0; i++) {
+    }
+    sign_ = rhs_sign;
+  }
+  shrink();
+  return *this;
 }
 
-big_integer operator^(big_integer a, big_integer const &b) {
-  return a ^= b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::add_product(basic_big_integer const &a,
+                                                                               basic_big_integer const &b,
+                                                                               bool negate) {
+  if (&a == this || &b == this) {
+    basic_big_integer p = a * b;
+    return negate ? *this -= p : *this += p;
+  }
+  size_t n = a.data_.size(), m = b.data_.size();
+  Limb const *pa = &a.data_[0];
+  Limb const *pb = &b.data_[0];
+  return accumulate(n + m, (a.sign_ != b.sign_) != negate, [=](Limb *res, size_t size, bool subtract) {
+    return subtract ? submul_limbs(res, size, pa, n, pb, m) : addmul_limbs(res, size, pa, n, pb, m);
+  });
 }
 
-big_integer operator<<(big_integer a, int b) {
-  return a <<= b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::add_shift(basic_big_integer const &a, int shift,
+                                                                             bool negate) {
+  if (&a == this) {
+    basic_big_integer s = a << shift;
+    return negate ? *this -= s : *this += s;
+  }
+  size_t n = a.data_.size(), limbs_cnt = shift / BASE;
+  uint32_t bits = shift % BASE;
+  Limb const *pa = &a.data_[0];
+  return accumulate(n + limbs_cnt + 1, a.sign_ != negate, [=](Limb *res, size_t size, bool subtract) {
+    return subtract ? subshl_limbs(res + limbs_cnt, size - limbs_cnt, pa, n, bits)
+                    : addshl_limbs(res + limbs_cnt, size - limbs_cnt, pa, n, bits);
+  });
 }
 
-big_integer operator>>(big_integer a, int b) {
-  return a >>= b;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator+=(
+    basic_big_product<Limb, Storage> const &rhs) {
+  return add_product(rhs.a, rhs.b, false);
 }
 
-bool operator==(big_integer const &a, big_integer const &b) {
-  return a.sign_ == b.sign_ && a.data_ == b.data_;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator-=(
+    basic_big_product<Limb, Storage> const &rhs) {
+  return add_product(rhs.a, rhs.b, true);
 }
 
-bool operator!=(big_integer const &a, big_integer const &b) {
-  return !(a == b);
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator+=(
+    basic_big_shift<Limb, Storage> const &rhs) {
+  return add_shift(rhs.a, rhs.shift, false);
 }
 
-bool operator<(big_integer const &a, big_integer const &b) {
-  if (a.sign_ != b.sign_) {
-    return a.sign_ && !b.sign_;
-  }
-  big_integer first = !a.sign_ ? a : b;
-  big_integer second = !a.sign_ ? b : a;
-  return (big_integer::compare_abs(first, second)) == -1;
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator-=(
+    basic_big_shift<Limb, Storage> const &rhs) {
+  return add_shift(rhs.a, rhs.shift, true);
 }
 
-bool operator>(big_integer const &a, big_integer const &b) {
-  return !(a < b) && (a != b);
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator<<=(int rhs) {
+  return shift_left(static_cast<size_t>(rhs));
 }
 
-bool operator<=(big_integer const &a, big_integer const &b) {
-  return (a < b) || (a == b);
+// rounds towards minus infinity, so the magnitude of a negative value grows by one if any bit set is shifted out
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator>>=(int rhs) {
+  return shift_right(static_cast<size_t>(rhs));
 }
 
-bool operator>=(big_integer const &a, big_integer const &b) {
-  return (a > b) || (a == b);
+// the shifts behind <<= and >>=, for internal shift counts that need not fit into an int
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::shift_left(size_t rhs) {
+  size_t limbs_cnt = rhs / BASE;
+  uint32_t shift = rhs % BASE;
+  size_t n = data_.size();
+  if (rhs == 0 || (n == 1 && data_[0] == 0)) {
+    return *this;
+  }
+  basic_big_integer const &self = *this;
+  bool spill = shift != 0 && (self.data_[n - 1] >> (BASE - shift)) != 0;
+  data_.resize(n + limbs_cnt + spill);
+  Limb *p = &data_[0];
+  if (shift == 0) {
+    std::copy_backward(p, p + n, p + n + limbs_cnt);
+  } else {
+    Limb top = shl_limbs(p + limbs_cnt, p, n, shift);
+    if (spill) {
+      p[n + limbs_cnt] = top;
+    }
+  }
+  std::fill(p, p + limbs_cnt, 0);
+  shrink();
+  return *this;
 }
 
-std::string to_string(big_integer const &a) {
-  if (a == ZERO) {
-    return "0";
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::shift_right(size_t rhs) {
+  size_t limbs_cnt = rhs / BASE;
+  uint32_t shift = rhs % BASE;
+  size_t n = data_.size();
+  if (limbs_cnt >= n) {
+    // everything is shifted out: -1 for negative values, 0 otherwise
+    data_.resize(1);
+    data_[0] = sign_ ? 1 : 0;
+    return *this;
   }
-  big_integer cur(a);
-  std::string ans;
-  while (cur != 0) {
-    ans += static_cast<char>(big_integer::remainder(cur, 10)) + '0';
-    cur = big_integer::quotient(cur, 10);
+  if (rhs == 0) {
+    return *this;
   }
-  if (a.sign_) {
-    ans += '-';
+  basic_big_integer const &lhs = *this;
+  bool round_up = sign_ && (significant(&lhs.data_[0], limbs_cnt) != 0 ||
+                            (lhs.data_[limbs_cnt] & ((static_cast<Limb>(1) << shift) - 1)) != 0);
+  Limb *p = &data_[0];
+  if (shift == 0) {
+    std::copy(p + limbs_cnt, p + n, p);
+  } else {
+    shr_limbs(p, p + limbs_cnt, n - limbs_cnt, shift);
   }
-  reverse(ans.begin(), ans.end());
-  return ans;
+  if (round_up) {
+    Limb one = 1;
+    if (add_limbs(p, p, n - limbs_cnt, &one, 1) != 0) {
+      p[n - limbs_cnt] = 1;
+      limbs_cnt--;
+    }
+  }
+  data_.resize(n - limbs_cnt);
+  shrink();
+  return *this;
 }
 
-std::ostream &operator<<(std::ostream &s, big_integer const &a) {
-  return s << to_string(a);
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::operator+() const {
+  return *this;
 }
+
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::negate() {
+  basic_big_integer const &self = *this;
+  if (data_.size() != 1 || self.data_[0] != 0) {
+    sign_ = !sign_;
+  }
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::operator-() const & {
+  basic_big_integer tmp(*this);
+  tmp.negate();
+  return tmp;
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::operator-() && {
+  negate();
+  return std::move(*this);
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::operator~() const {
+  basic_big_integer res(*this);
+  ++res;
+  res.sign_ = !res.sign_;
+  res.shrink();
+  return res;
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator++() {
+  Limb one = 1;
+  return add_signed(&one, 1, false);
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::operator++(int) {
+  basic_big_integer r = *this;
+  ++*this;
+  return r;
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> &basic_big_integer<Limb, Storage>::operator--() {
+  Limb one = 1;
+  return add_signed(&one, 1, true);
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::operator--(int) {
+  basic_big_integer r = *this;
+  --*this;
+  return r;
+}
+
+template <typename Limb, typename Storage>
+std::pair<basic_big_integer<Limb, Storage>, basic_big_integer<Limb, Storage>>
+basic_big_integer<Limb, Storage>::divide(basic_big_integer const &a, basic_big_integer const &b) {
+  if (compare_abs(a, b) < 0) {
+    return {0, a};
+  }
+  if (use_reciprocal(a, b)) {
+    return basic_big_reciprocal<Limb, Storage>(b).divmod(a);
+  }
+  size_t n = a.data_.size(), m = b.data_.size();
+  basic_big_integer q, r;
+  q.data_.resize(n - m + 1);
+  q.sign_ = a.sign_ != b.sign_;
+  r.sign_ = a.sign_;
+  if (m == 1) {
+    r.data_[0] = div_1(&q.data_[0], &a.data_[0], n, b.data_[0]);
+  } else {
+    uint32_t shift = leading_zeros(b.data_.back());
+    std::vector<Limb> rem(n + 1), d(m);
+    if (shift == 0) {
+      std::copy(&a.data_[0], &a.data_[0] + n, rem.begin());
+      std::copy(&b.data_[0], &b.data_[0] + m, d.begin());
+    } else {
+      rem[n] = shl_limbs(rem.data(), &a.data_[0], n, shift);
+      shl_limbs(d.data(), &b.data_[0], m, shift);
+    }
+    div_limbs(&q.data_[0], rem.data(), n + 1, d.data(), m);
+    r.data_.resize(m);
+    if (shift == 0) {
+      std::copy(rem.begin(), rem.begin() + m, &r.data_[0]);
+    } else {
+      shr_limbs(&r.data_[0], rem.data(), m, shift);
+    }
+  }
+  q.shrink();
+  r.shrink();
+  return {std::move(q), std::move(r)};
+}
+
+// the smallest k with len <= DECIMAL_DIGITS * 2^(k + 1): powers[k] splits len digits into two halves
+template <typename Limb, typename Storage>
+size_t basic_big_integer<Limb, Storage>::decimal_split(size_t len) {
+  size_t k = 0;
+  while ((DECIMAL_DIGITS << (k + 1)) < len) {
+    k++;
+  }
+  return k;
+}
+
+// powers[i] = 10^(DECIMAL_DIGITS * 2^i) for i <= k; parsing and printing share the table, which is squared up once
+// and kept. It is per thread, since concurrent growth, and with shared storage even reading, would race
+template <typename Limb, typename Storage>
+std::vector<basic_big_integer<Limb, Storage>> const &basic_big_integer<Limb, Storage>::decimal_powers(size_t k) {
+  static thread_local std::vector<basic_big_integer> powers;
+  if (powers.empty()) {
+    powers.push_back(from_limb(DECIMAL_BASE));
+  }
+  while (powers.size() <= k) {
+    powers.push_back(powers.back() * powers.back());
+  }
+  return powers;
+}
+
+// short inputs are read DECIMAL_DIGITS digits at a time into limbs, longer ones are split so that the low part has
+// DECIMAL_DIGITS * 2^k digits and recombined as high * powers[k] + low
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::read_decimal(
+    char const *s, size_t len, std::vector<basic_big_integer> const &powers) {
+  if (len <= RADIX_THRESHOLD * DECIMAL_DIGITS) {
+    basic_big_integer res;
+    res.data_.resize(len / DECIMAL_DIGITS + 1);
+    Limb *limbs = &res.data_[0];
+    size_t n = 0, step = len % DECIMAL_DIGITS == 0 ? DECIMAL_DIGITS : len % DECIMAL_DIGITS;
+    for (size_t pos = 0; pos < len; pos += step, step = DECIMAL_DIGITS) {
+      double_limb carry = 0;
+      for (size_t j = pos; j < pos + step; j++) {
+        carry = carry * 10 + (s[j] - '0');
+      }
+      for (size_t j = 0; j < n; j++) {
+        double_limb tmp = static_cast<double_limb>(limbs[j]) * DECIMAL_BASE + carry;
+        limbs[j] = static_cast<Limb>(tmp);
+        carry = simple_overflow(tmp);
+      }
+      if (carry != 0) {
+        limbs[n++] = static_cast<Limb>(carry);
+      }
+    }
+    res.shrink();
+    return res;
+  }
+  size_t k = decimal_split(len);
+  size_t low = DECIMAL_DIGITS << k;
+  basic_big_integer res = read_decimal(s, len - low, powers);
+  res *= powers[k];
+  return res += read_decimal(s + len - low, low, powers);
+}
+
+// writes 0 <= x < 10^(DECIMAL_DIGITS * 2^(k + 1)) as exactly that many digits, leading zeros included;
+// powers[i] = 10^(DECIMAL_DIGITS * 2^i) splits x in halves until the leaves are short enough for chunked division
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::write_decimal(char *out, basic_big_integer const &x,
+                                                     std::vector<basic_big_integer> const &powers, size_t k) {
+  size_t width = DECIMAL_DIGITS << (k + 1);
+  if (x.data_.size() < RADIX_THRESHOLD) {
+    basic_big_integer const &lhs = x;
+    std::vector<Limb> cur(&lhs.data_[0], &lhs.data_[0] + lhs.data_.size());
+    size_t n = significant(cur.data(), cur.size());
+    for (size_t pos = width; pos > 0; pos -= DECIMAL_DIGITS) {
+      Limb chunk = n == 0 ? 0 : div_1(cur.data(), cur.data(), n, DECIMAL_BASE);
+      n = significant(cur.data(), n);
+      for (size_t i = 1; i <= DECIMAL_DIGITS; i++) {
+        out[pos - i] = static_cast<char>('0' + chunk % 10);
+        chunk /= 10;
+      }
+    }
+    return;
+  }
+  std::pair<basic_big_integer, basic_big_integer> halves = divide(x, powers[k]);
+  write_decimal(out, halves.first, powers, k - 1);
+  write_decimal(out + width / 2, halves.second, powers, k - 1);
+}
+
+template <typename Limb, typename Storage>
+std::string basic_big_integer<Limb, Storage>::to_decimal(basic_big_integer const &a) {
+  if (a.data_.size() == 1 && a.data_[0] == 0) {
+    return "0";
+  }
+  // log10(2) < 0.30103
+  size_t digits = a.data_.size() * BASE * 30103 / 100000 + 1;
+  size_t k = decimal_split(digits);
+  std::string ans(DECIMAL_DIGITS << (k + 1), '0');
+  write_decimal(&ans[0], a.sign_ ? -a : a, decimal_powers(k), k);
+  ans.erase(0, ans.find_first_not_of('0'));
+  if (a.sign_) {
+    ans.insert(ans.begin(), '-');
+  }
+  return ans;
+}
+
+template <typename Limb, typename Storage>
+std::ostream &basic_big_integer<Limb, Storage>::print(std::ostream &s, basic_big_integer const &a) {
+  return s << to_decimal(a);
+}
+
+template <typename Limb, typename Storage>
+basic_big_reciprocal<Limb, Storage>::basic_big_reciprocal(integer const &divisor)
+    : sign_(divisor.sign_),
+      shift_(integer::leading_zeros(divisor.data_.back())),
+      size_(divisor.data_.size()),
+      divisor_(divisor.sign_ ? -divisor : divisor) {
+  divisor_ <<= shift_;
+  inverse_ = invert(divisor_, size_);
+}
+
+// BASE^(2m) / d within a few units for a normalized m-limb d: the inverse x of the top h limbs of d is lifted
+// by one Newton step x + x * (BASE^(m + h) - d * x) / BASE^(2h), which doubles the number of correct limbs
+template <typename Limb, typename Storage>
+typename basic_big_reciprocal<Limb, Storage>::integer basic_big_reciprocal<Limb, Storage>::invert(integer const &d,
+                                                                                                  size_t m) {
+  int const base = static_cast<int>(integer::BASE);
+  if (m < integer::NEWTON_THRESHOLD) {
+    return (integer(1) << static_cast<int>(2 * m) * base) / d;
+  }
+  size_t h = m / 2 + 2;
+  integer x = invert(d >> static_cast<int>(m - h) * base, h);
+  integer t = x * ((integer(1) << static_cast<int>(m + h) * base) - d * x);
+  bool negative = t.sign_;
+  t.sign_ = false;
+  t >>= static_cast<int>(2 * h) * base;
+  x <<= static_cast<int>(m - h) * base;
+  return negative ? x - t : x + t;
+}
+
+// |a| << shift_ is split into size_-limb blocks, every step divides a 2 * size_-limb value with two multiplications
+// and a few corrections
+template <typename Limb, typename Storage>
+void basic_big_reciprocal<Limb, Storage>::divide(integer const &a, integer &q, integer &r) const {
+  int const block_bits = static_cast<int>(size_ * integer::BASE);
+  integer num = a.sign_ ? -a : a;
+  num <<= shift_;
+  size_t n = num.data_.size(), blocks = (n + size_ - 1) / size_;
+  q.data_.resize(blocks * size_);
+  r = 0;
+  for (size_t b = blocks; b > 0; b--) {
+    size_t first = (b - 1) * size_, last = std::min(b * size_, n);
+    integer cur;
+    cur.data_.resize(last - first);
+    for (size_t i = first; i < last; i++) {
+      cur.data_[i - first] = num.data_[i];
+    }
+    cur.shrink();
+    cur += r << block_bits;
+
+    integer qt = ((cur >> (block_bits - static_cast<int>(integer::BASE))) * inverse_)
+        >> (block_bits + static_cast<int>(integer::BASE));
+    r = cur - qt * divisor_;
+    while (r.sign_) {
+      r += divisor_;
+      --qt;
+    }
+    while (r >= divisor_) {
+      r -= divisor_;
+      ++qt;
+    }
+    for (size_t i = 0; i < size_; i++) {
+      q.data_[first + i] = i < qt.data_.size() ? qt.data_[i] : 0;
+    }
+  }
+  q.shrink();
+}
+
+template <typename Limb, typename Storage>
+typename basic_big_reciprocal<Limb, Storage>::integer
+basic_big_reciprocal<Limb, Storage>::quotient(integer const &a) const {
+  integer q, r;
+  divide(a, q, r);
+  q.sign_ = a.sign_ != sign_;
+  q.shrink();
+  return q;
+}
+
+template <typename Limb, typename Storage>
+typename basic_big_reciprocal<Limb, Storage>::integer
+basic_big_reciprocal<Limb, Storage>::remainder(integer const &a) const {
+  return divmod(a).second;
+}
+
+template <typename Limb, typename Storage>
+std::pair<typename basic_big_reciprocal<Limb, Storage>::integer, typename basic_big_reciprocal<Limb, Storage>::integer>
+basic_big_reciprocal<Limb, Storage>::divmod(integer const &a) const {
+  integer q, r;
+  divide(a, q, r);
+  q.sign_ = a.sign_ != sign_;
+  q.shrink();
+  r >>= shift_;
+  r.sign_ = a.sign_;
+  r.shrink();
+  return {std::move(q), std::move(r)};
+}
+
+template <typename Limb, typename Storage>
+basic_big_divisor<Limb, Storage>::basic_big_divisor(integer const &divisor)
+    : sign_(divisor.sign_),
+      shift_(divisor.data_.size() == 1 ? 0 : integer::leading_zeros(divisor.data_.back())),
+      size_(divisor.data_.size()),
+      divisor_(size_) {
+  if (shift_ == 0) {
+    for (size_t i = 0; i < size_; i++) {
+      divisor_[i] = divisor.data_[i];
+    }
+  } else {
+    integer::shl_limbs(divisor_.data(), &divisor.data_[0], size_, shift_);
+  }
+  if (size_ >= integer::BARRETT_THRESHOLD && size_ <= integer::BARRETT_MAX_SIZE) {
+    integer d;
+    d.data_.resize(size_);
+    for (size_t i = 0; i < size_; i++) {
+      d.data_[i] = divisor_[i];
+    }
+    integer mu = (integer(1) << static_cast<int>(2 * size_ * integer::BASE)) / d;
+    mu_.resize(size_ + 1);
+    for (size_t i = 0; i < mu.data_.size(); i++) {
+      mu_[i] = mu.data_[i];
+    }
+  }
+}
+
+// a has 2k limbs and is below BASE^(2k): the estimate ((a / BASE^(k - 1)) * mu) / BASE^(k + 1) falls short of the
+// quotient by three at most, so the remainder is below 4d and fits into the low k + 1 limbs of a - q * d; q gets k + 1
+// limbs, the remainder is left in a[0, k)
+template <typename Limb, typename Storage>
+void basic_big_divisor<Limb, Storage>::barrett(Limb *q, Limb *a) const {
+  size_t k = size_;
+  Limb const *d = divisor_.data();
+  std::vector<Limb> t(4 * k + 3);
+  Limb *estimate = t.data(), *product = estimate + 2 * k + 2;
+  // only columns k - 1 and up of the estimate and columns up to k of the product are needed: dropping the lower
+  // columns of the estimate costs one more unit of it at most
+  std::fill(t.begin(), t.end(), 0);
+  for (size_t i = 0; i <= k; i++) {
+    size_t from = i < k - 1 ? k - 1 - i : 0;
+    estimate[i + k + 1] = integer::addmul_1(estimate + i + from, mu_.data() + from, k + 1 - from, a[k - 1 + i]);
+  }
+  std::copy(estimate + k + 1, estimate + 2 * k + 2, q);
+  product[k] = integer::addmul_1(product, d, k, q[0]);
+  for (size_t i = 1; i <= k; i++) {
+    integer::addmul_1(product + i, d, k + 1 - i, q[i]);
+  }
+  integer::sub_limbs(a, a, k + 1, product, k + 1);
+  Limb const one = 1;
+  while (a[k] != 0 || integer::compare_limbs(a, k, d, k) >= 0) {
+    a[k] -= integer::sub_limbs(a, a, k, d, k);
+    integer::add_limbs(q, q, k + 1, &one, 1);
+  }
+}
+
+template <typename Limb, typename Storage>
+std::pair<typename basic_big_divisor<Limb, Storage>::integer, typename basic_big_divisor<Limb, Storage>::integer>
+basic_big_divisor<Limb, Storage>::divmod(integer const &a) const {
+  size_t n = a.data_.size(), k = size_;
+  integer q, r;
+  q.sign_ = a.sign_ != sign_;
+  r.sign_ = a.sign_;
+  if (k == 1) {
+    q.data_.resize(n);
+    r.data_[0] = integer::div_1(&q.data_[0], &a.data_[0], n, divisor_[0]);
+  } else {
+    std::vector<Limb> rem(std::max(n + 1, 2 * k));
+    if (shift_ == 0) {
+      std::copy(&a.data_[0], &a.data_[0] + n, rem.begin());
+    } else {
+      rem[n] = integer::shl_limbs(rem.data(), &a.data_[0], n, shift_);
+    }
+    if (integer::compare_limbs(rem.data(), n + 1, divisor_.data(), k) < 0) {
+      return {0, a};
+    }
+    if (!mu_.empty() && integer::significant(rem.data(), rem.size()) <= 2 * k) {
+      q.data_.resize(k + 1);
+      barrett(&q.data_[0], rem.data());
+    } else {
+      q.data_.resize(n - k + 1);
+      integer::div_limbs(&q.data_[0], rem.data(), n + 1, divisor_.data(), k);
+    }
+    r.data_.resize(k);
+    if (shift_ == 0) {
+      std::copy(rem.begin(), rem.begin() + k, &r.data_[0]);
+    } else {
+      integer::shr_limbs(&r.data_[0], rem.data(), k, shift_);
+    }
+  }
+  q.shrink();
+  r.shrink();
+  return {std::move(q), std::move(r)};
+}
+
+template <typename Limb, typename Storage>
+typename basic_big_divisor<Limb, Storage>::integer basic_big_divisor<Limb, Storage>::div(integer const &a) const {
+  return divmod(a).first;
+}
+
+template <typename Limb, typename Storage>
+typename basic_big_divisor<Limb, Storage>::integer basic_big_divisor<Limb, Storage>::mod(integer const &a) const {
+  return divmod(a).second;
+}
+
+// odd moduli go through a Montgomery context, even ones are left to binary powering with a division per step
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::power_mod(basic_big_integer const &base,
+                                                                            basic_big_integer const &exp,
+                                                                            basic_big_integer const &mod) {
+  basic_big_integer m = mod.sign_ ? -mod : mod;
+  if ((m.data_[0] & 1u) != 0) {
+    return basic_montgomery_context<Limb, Storage>(m).powmod(base, exp);
+  }
+  basic_big_integer b = base % m, res = 1;
+  if (b.sign_) {
+    b += m;
+  }
+  size_t bits = exp.bit_length();
+  for (size_t i = bits; i > 0; i--) {
+    res = res * res % m;
+    if (((exp.data_[(i - 1) / BASE] >> ((i - 1) % BASE)) & 1u) != 0) {
+      res = res * b % m;
+    }
+  }
+  return res % m;
+}
+
+template <typename Limb, typename Storage>
+uint32_t basic_big_integer<Limb, Storage>::trailing_zeros(double_limb x) {
+  Limb low = static_cast<Limb>(x);
+  return low != 0 ? static_cast<uint32_t>(__builtin_ctzll(low))
+                  : BASE + static_cast<uint32_t>(__builtin_ctzll(static_cast<Limb>(x >> BASE)));
+}
+
+// Stein's algorithm: common factors of two are taken out once, then the smaller odd value is subtracted from the
+// larger one, which stays even until its zeros are shifted out
+template <typename Limb, typename Storage>
+typename basic_big_integer<Limb, Storage>::double_limb basic_big_integer<Limb, Storage>::binary_gcd(double_limb a,
+                                                                                                   double_limb b) {
+  if (a == 0 || b == 0) {
+    return a | b;
+  }
+  uint32_t common = trailing_zeros(a | b);
+  a >>= trailing_zeros(a);
+  while (b != 0) {
+    b >>= trailing_zeros(b);
+    if (a > b) {
+      std::swap(a, b);
+    }
+    b -= a;
+  }
+  return a << common;
+}
+
+// res = p * |a| + q * |b| if add is set, |p * |a| - q * |b|| otherwise, true if the difference is negative
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::combine(basic_big_integer &res, basic_big_integer const &a,
+                                               basic_big_integer const &b, Limb p, Limb q, bool add) {
+  size_t na = a.data_.size(), nb = b.data_.size(), n = std::max(na, nb);
+  res.data_.resize(n + 1);
+  Limb *r = &res.data_[0];
+  std::fill(r, r + n + 1, 0);
+  Limb carry = addmul_1(r, &a.data_[0], na, p);
+  add_limbs(r + na, r + na, n + 1 - na, &carry, 1);
+  bool negative = false;
+  if (add) {
+    carry = addmul_1(r, &b.data_[0], nb, q);
+    add_limbs(r + nb, r + nb, n + 1 - nb, &carry, 1);
+  } else {
+    Limb borrow = submul_1(r, &b.data_[0], nb, q);
+    negative = sub_limbs(r + nb, r + nb, n + 1 - nb, &borrow, 1) != 0;
+  }
+  if (negative) {
+    for (size_t i = 0; i <= n; i++) {
+      r[i] = ~r[i];
+    }
+    Limb one = 1;
+    add_limbs(r, r, n + 1, &one, 1);
+  }
+  res.sign_ = false;
+  res.shrink();
+  return negative;
+}
+
+// res = p * a - q * b for signed a and b, negated if negate is set
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::combine_signed(basic_big_integer &res, basic_big_integer const &a,
+                                                      basic_big_integer const &b, Limb p, Limb q, bool negate) {
+  // signs of the two terms, a zero term takes the sign of the other one
+  bool first = a.sign_, second = !b.sign_;
+  if (p == 0 || (a.data_.size() == 1 && a.data_[0] == 0)) {
+    first = second;
+  } else if (q == 0 || (b.data_.size() == 1 && b.data_[0] == 0)) {
+    second = first;
+  }
+  bool sign = first;
+  if (first == second) {
+    combine(res, a, b, p, q, true);
+  } else if (combine(res, a, b, p, q, false)) {
+    sign = !sign;
+  }
+  if (sign != negate) {
+    res.negate();
+  }
+}
+
+// one remainder step on a >= b > 0 that leaves b with more than s limbs, false if there is none. From three limbs
+// on, Euclid runs on the leading 2 * BASE bits of both values for as long as Jebelean's condition guarantees the
+// quotients of the values themselves and the cofactors fit into a limb (Lehmer); the cofactors are then applied to
+// a and b at once. Where the leading bits decide nothing a single division is made. The rows of m, if given, follow
+// the values: (a, b) = m (a0, b0) for the a0 and b0 m started from
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::gcd_step(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m,
+                                                size_t s) {
+  basic_big_integer const &x = a, &y = b;
+  size_t n = x.data_.size();
+  if (n >= 3) {
+    uint32_t shift = leading_zeros(x.data_[n - 1]);
+    auto top = [&](basic_big_integer const &v) {
+      auto limb = [&](size_t i) { return i < v.data_.size() ? static_cast<double_limb>(v.data_[i]) : 0; };
+      double_limb t = (limb(n - 1) << BASE | limb(n - 2)) << shift;
+      return shift == 0 ? t : t | limb(n - 3) >> (BASE - shift);
+    };
+    double_limb hx = top(x), hy = top(y);
+    // remainders of the leading bits below this bound would leave b with s limbs or fewer
+    size_t low = (n - 2) * BASE - shift;
+    double_limb bound = 0;
+    if (s * BASE > low) {
+      size_t bits = s * BASE - low;
+      bound = bits >= 2 * BASE ? ~static_cast<double_limb>(0) : static_cast<double_limb>(1) << bits;
+    }
+    // the i-th remainder is (-1)^i (s_i * hx - t_i * hy), (s0, t0) and (s1, t1) are the last two cofactor pairs
+    Limb s0 = 1, t0 = 0, s1 = 0, t1 = 1;
+    size_t steps = 0;
+    while (hy != 0) {
+      double_limb q = 1, r = hx - hy;
+      if (r >= hy) {
+        q = hx / hy;
+        r = hx - q * hy;
+      }
+      if (q > MAX_VALUE) {
+        break;
+      }
+      double_limb s2 = s0 + q * s1, t2 = t0 + q * t1, c = std::max(s2, t2);
+      if (c > MAX_VALUE || r < c || hy - r < c + std::max(s1, t1) || r < bound) {
+        break;
+      }
+      hx = hy;
+      hy = r;
+      s0 = s1;
+      t0 = t1;
+      s1 = static_cast<Limb>(s2);
+      t1 = static_cast<Limb>(t2);
+      steps++;
+    }
+    if (steps != 0) {
+      basic_big_integer u, v;
+      bool odd = steps % 2 == 1;
+      bool u_negative = combine(u, x, y, s0, t0, false), v_negative = combine(v, x, y, s1, t1, false);
+      bool v_zero = v.data_.size() == 1 && v.data_[0] == 0;
+      // the signs and the order tell whether these are the remainders of a and b, the size is up to s
+      if (u_negative == odd && (v_zero || v_negative != odd) && compare_abs(u, v) > 0 && v.data_.size() > s) {
+        if (m != nullptr) {
+          for (size_t j = 0; j < 2; j++) {
+            basic_big_integer mu, mv;
+            combine_signed(mu, m[j], m[2 + j], s0, t0, u_negative);
+            combine_signed(mv, m[j], m[2 + j], s1, t1, v_negative);
+            m[j] = std::move(mu);
+            m[2 + j] = std::move(mv);
+          }
+        }
+        a = std::move(u);
+        b = std::move(v);
+        return true;
+      }
+    }
+  }
+  std::pair<basic_big_integer, basic_big_integer> qr = divide(a, b);
+  if (qr.second.data_.size() <= s) {
+    return false;
+  }
+  if (m != nullptr) {
+    for (size_t j = 0; j < 2; j++) {
+      basic_big_integer t = m[j] - qr.first * m[2 + j];
+      m[j] = std::move(m[2 + j]);
+      m[2 + j] = std::move(t);
+    }
+  }
+  a = std::move(b);
+  b = std::move(qr.second);
+  return true;
+}
+
+// m = t * m for 2x2 matrices stored by rows
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::gcd_compose(basic_big_integer *m, basic_big_integer const *t) {
+  basic_big_integer r[4];
+  for (size_t i = 0; i < 2; i++) {
+    for (size_t j = 0; j < 2; j++) {
+      r[2 * i + j] = t[2 * i] * m[j];
+      r[2 * i + j] += mul(t[2 * i + 1], m[2 + j]);
+    }
+  }
+  for (size_t i = 0; i < 4; i++) {
+    m[i] = std::move(r[i]);
+  }
+}
+
+// reduces the limbs of a and b from p on with half_gcd and carries its matrix over to the whole values; the low
+// limbs shift the results by less than the matrix entries times BASE^p, so they are kept, and the matrix composed
+// into m, only if they still are consecutive remainders a > b >= 0
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::gcd_lift(basic_big_integer &a, basic_big_integer &b, size_t p,
+                                                basic_big_integer *m) {
+  int const bits = static_cast<int>(p * BASE);
+  basic_big_integer ta = a >> bits, tb = b >> bits, t[4];
+  if (!half_gcd(ta, tb, t)) {
+    return false;
+  }
+  auto low = [p](basic_big_integer const &v) {
+    basic_big_integer res;
+    size_t k = std::min(p, v.data_.size());
+    res.data_.resize(k);
+    for (size_t i = 0; i < k; i++) {
+      res.data_[i] = v.data_[i];
+    }
+    res.shrink();
+    return res;
+  };
+  basic_big_integer al = low(a), bl = low(b);
+  ta <<= bits;
+  ta += mul(t[0], al);
+  ta += mul(t[1], bl);
+  tb <<= bits;
+  tb += mul(t[2], al);
+  tb += mul(t[3], bl);
+  if (tb.sign_ || compare(ta, tb) <= 0) {
+    return false;
+  }
+  a = std::move(ta);
+  b = std::move(tb);
+  if (m != nullptr) {
+    gcd_compose(m, t);
+  }
+  return true;
+}
+
+// reduces a >= b >= 0 of n limbs by remainder steps while b keeps more than n / 2 + 1 limbs and sets m to the
+// matrix of these steps, false if there was none. The upper half of the limbs is reduced first by a recursive call
+// on it, then the upper half of what is left, so only the final steps run on the whole values and the reduction
+// costs O(M(n) log n)
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::half_gcd(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m) {
+  size_t n = a.data_.size(), s = n / 2 + 1;
+  // the identity, written in place
+  for (size_t i = 0; i < 4; i++) {
+    m[i].data_.resize(1);
+    m[i].data_[0] = i == 0 || i == 3 ? 1 : 0;
+    m[i].sign_ = false;
+  }
+  if (b.data_.size() <= s) {
+    return false;
+  }
+  bool progress = false;
+  if (n >= HGCD_THRESHOLD) {
+    progress = gcd_lift(a, b, n / 2, m);
+    size_t k = a.data_.size();
+    if (b.data_.size() > s && gcd_lift(a, b, 2 * s - k, m)) {
+      progress = true;
+    }
+  }
+  while (gcd_step(a, b, m, s)) {
+    progress = true;
+  }
+  return progress;
+}
+
+// a and b of at most two limbs are reduced to (gcd, 0) within double limbs
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::gcd_tail(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m) {
+  auto value = [](basic_big_integer const &v) {
+    return v.data_.size() == 1 ? v.data_[0] : static_cast<double_limb>(v.data_[1]) << BASE | v.data_[0];
+  };
+  double_limb x = value(a), y = value(b);
+  if (m == nullptr) {
+    a = from_double_limb(binary_gcd(x, y));
+  } else {
+    // the i-th remainder is (-1)^i (s_i * a - t_i * b), as in gcd_step
+    double_limb s0 = 1, t0 = 0, s1 = 0, t1 = 1;
+    bool odd = false;
+    while (y != 0) {
+      double_limb q = x / y, r = x - q * y;
+      x = y;
+      y = r;
+      double_limb s2 = s0 + q * s1, t2 = t0 + q * t1;
+      s0 = s1;
+      t0 = t1;
+      s1 = s2;
+      t1 = t2;
+      odd = !odd;
+    }
+    for (size_t j = 0; j < 2; j++) {
+      basic_big_integer mu = from_double_limb(s0) * m[j] - from_double_limb(t0) * m[2 + j];
+      basic_big_integer mv = from_double_limb(s1) * m[j] - from_double_limb(t1) * m[2 + j];
+      if (odd) {
+        mu.negate();
+      } else {
+        mv.negate();
+      }
+      m[j] = std::move(mu);
+      m[2 + j] = std::move(mv);
+    }
+    a = from_double_limb(x);
+  }
+  b = 0;
+}
+
+// a >= b >= 0 are reduced to (gcd, 0): a half-gcd of the upper two thirds of the limbs at a time while they are
+// long enough, Lehmer steps after that and double-limb arithmetic for the last two limbs
+template <typename Limb, typename Storage>
+void basic_big_integer<Limb, Storage>::gcd_reduce(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m) {
+  while (b.data_.size() != 1 || b.data_[0] != 0) {
+    size_t n = a.data_.size();
+    if (n <= 2) {
+      gcd_tail(a, b, m);
+      return;
+    }
+    if (n < GCD_DC_THRESHOLD || !gcd_lift(a, b, n / 3, m)) {
+      gcd_step(a, b, m, 0);
+    }
+  }
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::common_divisor(basic_big_integer const &a,
+                                                                                  basic_big_integer const &b) {
+  basic_big_integer x = a.sign_ ? -a : a, y = b.sign_ ? -b : b;
+  if (compare_abs(x, y) < 0) {
+    std::swap(x, y);
+  }
+  gcd_reduce(x, y, nullptr);
+  return x;
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::common_multiple(basic_big_integer const &a,
+                                                                                   basic_big_integer const &b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  basic_big_integer res = a / common_divisor(a, b) * b;
+  res.sign_ = false;
+  return res;
+}
+
+// the reduction keeps the matrix with (g, 0) = m (|a|, |b|): its first row gives Bezout coefficients, the second
+// one |b| / g, by which the coefficient of a is moved into [0, |b| / g); the one of b then follows from
+// a * x + b * y = g
+template <typename Limb, typename Storage>
+std::tuple<basic_big_integer<Limb, Storage>, basic_big_integer<Limb, Storage>, basic_big_integer<Limb, Storage>>
+basic_big_integer<Limb, Storage>::extended_gcd(basic_big_integer const &a, basic_big_integer const &b) {
+  basic_big_integer x = a.sign_ ? -a : a, y = b.sign_ ? -b : b, m[4] = {1, 0, 0, 1};
+  bool swapped = compare_abs(x, y) < 0;
+  if (swapped) {
+    std::swap(x, y);
+  }
+  gcd_reduce(x, y, m);
+  basic_big_integer ca = m[swapped ? 1 : 0], cb = m[swapped ? 0 : 1], period = m[swapped ? 3 : 2];
+  if (b == 0) {
+    return std::make_tuple(std::move(x), a == 0 ? 0 : a.sign_ ? -1 : 1, 0);
+  }
+  if (a.sign_) {
+    ca.negate();
+  }
+  period.sign_ = false;
+  ca %= period;
+  if (ca.sign_) {
+    ca += period;
+  }
+  cb = (x - a * ca) / b;
+  return std::make_tuple(std::move(x), std::move(ca), std::move(cb));
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::inverse_mod(basic_big_integer const &a,
+                                                                               basic_big_integer const &mod) {
+  std::tuple<basic_big_integer, basic_big_integer, basic_big_integer> r = extended_gcd(a, mod.sign_ ? -mod : mod);
+  return std::get<0>(r) == 1 ? std::move(std::get<1>(r)) : 0;
+}
+
+// The factors of two of the base become a shift of the result, so a power of two costs no multiplication at all.
+// The exponent is scanned from the top as in montgomery powmod, and while the power of an odd single-limb base
+// still fits a limb, the leading bits are taken in limb arithmetic.
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::power(basic_big_integer const &x, size_t e) {
+  if (e == 0) {
+    return 1;
+  }
+  if (x.bit_length() == 0) {
+    return x;
+  }
+  size_t zeros = x.low_zero_bits(), bits = 0;
+  // a power of two is nothing but this shift, so a huge e would otherwise reach it with a wrapped count
+  if (zeros != 0 && e > SIZE_MAX / zeros) {
+    throw std::length_error("pow result does not fit into memory");
+  }
+  basic_big_integer b = x.sign_ ? -x : x;
+  b.shift_right(zeros);
+  while (bits < sizeof(size_t) * CHAR_BIT && e >> bits != 0) {
+    bits++;
+  }
+  size_t i = bits - 1;
+  basic_big_integer res;
+  if (b.data_.size() == 1) {
+    double_limb acc = b.data_[0];
+    while (i > 0) {
+      double_limb next = acc * acc;
+      if (next > MAX_VALUE) {
+        break;
+      }
+      if ((e >> (i - 1) & 1) != 0) {
+        next *= b.data_[0];
+        if (next > MAX_VALUE) {
+          break;
+        }
+      }
+      acc = next;
+      i--;
+    }
+    res = from_limb(static_cast<Limb>(acc));
+  } else {
+    res = b;
+  }
+  if (i > 0) {
+    size_t k = i > 671 ? 6 : i > 239 ? 5 : i > 79 ? 4 : i > 23 ? 3 : i > 7 ? 2 : 1;
+    std::vector<basic_big_integer> table(static_cast<size_t>(1) << (k - 1), b);
+    if (k > 1) {
+      basic_big_integer square = b * b;
+      for (size_t j = 1; j < table.size(); j++) {
+        table[j] = table[j - 1] * square;
+      }
+    }
+    for (size_t j = i; j > 0;) {
+      if ((e >> (j - 1) & 1) == 0) {
+        res *= res;
+        j--;
+        continue;
+      }
+      size_t low = j > k ? j - k : 0;
+      while ((e >> low & 1) == 0) {
+        low++;
+      }
+      for (size_t t = low; t < j; t++) {
+        res *= res;
+      }
+      res *= table[(e >> low & ((static_cast<size_t>(1) << (j - low)) - 1)) >> 1];
+      j = low;
+    }
+  }
+  res.shift_left(zeros * e);
+  res.sign_ = x.sign_ && (e & 1) != 0;
+  return res;
+}
+
+// |a| ~ top * 2^shift, from the upper three limbs
+template <typename Limb, typename Storage>
+double basic_big_integer<Limb, Storage>::leading_bits(basic_big_integer const &a, size_t &shift) {
+  size_t n = a.data_.size(), low = n > 3 ? n - 3 : 0;
+  double top = 0;
+  for (size_t i = n; i > low; i--) {
+    top = std::ldexp(top, BASE) + static_cast<double>(a.data_[i - 1]);
+  }
+  shift = low * BASE;
+  return top;
+}
+
+// (top * 2^shift)^(1 / k) to about 2^-50 relative, for results that fit a double; the shift is divided out exactly
+// so that exp2 only sees a small argument
+template <typename Limb, typename Storage>
+double basic_big_integer<Limb, Storage>::root_estimate(double top, size_t shift, size_t k) {
+  double scale = static_cast<double>(k);
+  return std::ldexp(std::exp2((static_cast<double>(shift % k) + std::log2(top)) / scale), static_cast<int>(shift / k));
+}
+
+// Newton's iteration x -> ((k - 1) x + a / x^(k - 1)) / k, rounded down, moves any x above the root of a down to
+// at least its floor and stops decreasing there. It starts from the root of the upper bits of a, computed the same
+// way with about half as many bits in the root and shifted back with one added, which is close enough for a single
+// step and a check, so the cost is dominated by the last division. Roots of at most 32 bits start from
+// root_estimate instead.
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::root(basic_big_integer const &a, size_t k) {
+  if (a.sign_) {
+    basic_big_integer res = root(-a, k);
+    res.negate();
+    return res;
+  }
+  size_t n = a.bit_length();
+  if (k == 1 || n == 0) {
+    return a;
+  }
+  if (n <= k) {
+    return 1;
+  }
+  size_t m = (n - 1) / k + 1, log_k = 0;
+  while (k >> log_k != 0) {
+    log_k++;
+  }
+  basic_big_integer x;
+  if (m <= 32) {
+    size_t shift;
+    double top = leading_bits(a, shift);
+    x = from_double_limb(static_cast<double_limb>(root_estimate(top, shift, k) * (1 + 1e-12)) + 2);
+  } else {
+    size_t h = m > log_k + 5 ? (m - log_k - 3) / 2 : 1;
+    x = root(a >> static_cast<int>(k * h), k);
+    ++x;
+    x <<= static_cast<int>(h);
+  }
+  basic_big_integer const k1 = from_limb(static_cast<Limb>(k - 1)), kk = from_limb(static_cast<Limb>(k));
+  while (true) {
+    basic_big_integer t = power(x, k - 1);
+    if (t * x <= a) {
+      return x;
+    }
+    x = (x * k1 + a / t) / kk;
+  }
+}
+
+// whether |a| mod q is a p-th power residue, that is (a mod q)^((q - 1) / p) is 0 or 1, for the first four primes
+// q = 1 (mod p) below 2^31: a p-th power always passes, other values fail each prime with probability 1 - 1 / p
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::power_residue(basic_big_integer const &a, size_t p) {
+  size_t found = 0;
+  for (uint64_t q = 2 * p + 1; found < 4 && q < (uint64_t(1) << 31); q += 2 * p) {
+    bool prime = true;
+    for (uint64_t d = 3; prime && d * d <= q; d += 2) {
+      prime = q % d != 0;
+    }
+    if (!prime) {
+      continue;
+    }
+    found++;
+    double_limb r = 0;
+    for (size_t i = a.data_.size(); i > 0; i--) {
+      r = ((r << BASE) + a.data_[i - 1]) % q;
+    }
+    uint64_t base = static_cast<uint64_t>(r), res = 1;
+    for (uint64_t e = (q - 1) / p; e != 0; e >>= 1) {
+      if (e & 1) {
+        res = res * base % q;
+      }
+      base = base * base % q;
+    }
+    if (r != 0 && res != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// a = x^k for some k >= 2 only if it holds for a prime k, which is at most the bit length of |a|, odd if a < 0
+// and a divisor of the trailing zero count of |a| if there are any. A root of at most 32 bits is ruled out by
+// root_estimate alone unless it is near an integer and the rest mostly by power_residue, which leaves the full
+// check to actual powers and a few exponents in between.
+template <typename Limb, typename Storage>
+bool basic_big_integer<Limb, Storage>::perfect_power(basic_big_integer const &a) {
+  basic_big_integer x = a.sign_ ? -a : a;
+  size_t n = x.bit_length();
+  if (n <= 1) {
+    return true;
+  }
+  size_t zeros = x.low_zero_bits();
+  size_t shift;
+  double top = leading_bits(x, shift);
+  for (size_t p : primes_up_to(n)) {
+    if ((a.sign_ && p == 2) || (zeros != 0 && zeros % p != 0)) {
+      continue;
+    }
+    if ((n - 1) / p < 32) {
+      double estimate = root_estimate(top, shift, p);
+      if (std::fabs(estimate - std::round(estimate)) > 1e-3) {
+        continue;
+      }
+    }
+    if (power_residue(x, p) && power(root(x, p), p) == x) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Limb, typename Storage>
+std::vector<size_t> basic_big_integer<Limb, Storage>::primes_up_to(size_t n) {
+  std::vector<bool> composite(n + 1);
+  std::vector<size_t> primes;
+  for (size_t p = 2; p <= n; p++) {
+    if (!composite[p]) {
+      primes.push_back(p);
+      for (size_t q = p * p; q <= n; q += p) {
+        composite[q] = true;
+      }
+    }
+  }
+  return primes;
+}
+
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::product_tree(
+    std::vector<basic_big_integer> const &factors) {
+  if (factors.empty()) {
+    return 1;
+  }
+  std::vector<size_t> sizes(factors.size() + 1);
+  for (size_t i = 0; i < factors.size(); i++) {
+    sizes[i + 1] = sizes[i] + factors[i].data_.size();
+  }
+  return product_range(factors, sizes, 0, factors.size());
+}
+
+// the factors in [first, last) are split where the prefix sums of their sizes cross the middle, so that the two
+// halves, and with them the operands of each multiplication, are about as long; ranges that fit the schoolbook
+// multiplication are folded left to right, starting from the product of the first two, so that no factor is copied
+// unless it is alone in its range
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::product_range(
+    std::vector<basic_big_integer> const &factors, std::vector<size_t> const &sizes, size_t first, size_t last) {
+  if (last - first == 1) {
+    return factors[first];
+  }
+  if (last - first == 2 || sizes[last] - sizes[first] <= KARATSUBA_THRESHOLD) {
+    basic_big_integer res = factors[first] * factors[first + 1];
+    for (size_t i = first + 2; i < last; i++) {
+      res *= factors[i];
+    }
+    return res;
+  }
+  size_t half = sizes[first] + (sizes[last] - sizes[first] + 1) / 2;
+  size_t mid = std::lower_bound(sizes.begin() + first + 1, sizes.begin() + last, half) - sizes.begin();
+  if (mid == last) {
+    mid--;
+  }
+  basic_big_integer res = product_range(factors, sizes, first, mid);
+  res *= product_range(factors, sizes, mid, last);
+  return res;
+}
+
+// values that fit a limb are packed into as few limbs as their products fit into
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::product_of(std::vector<size_t> const &values) {
+  std::vector<basic_big_integer> factors;
+  Limb pack = 1;
+  for (size_t v : values) {
+    if (v > MAX_VALUE) {
+      factors.push_back(from_double_limb(v));
+    } else if (static_cast<double_limb>(pack) * v > MAX_VALUE) {
+      factors.push_back(from_limb(pack));
+      pack = static_cast<Limb>(v);
+    } else {
+      pack *= static_cast<Limb>(v);
+    }
+  }
+  factors.push_back(from_limb(pack));
+  return product_tree(factors);
+}
+
+// prod primes[i]^exps[i] a bit of the exponents at a time from the top, res = res^2 * (the primes with that bit set),
+// so every product is of many similar factors and the squarings are of the full result; two is a shift at the end
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::power_product(std::vector<size_t> const &primes,
+                                                                                 std::vector<size_t> const &exps) {
+  size_t twos = 0, top = 0, bits = 0;
+  for (size_t i = 0; i < primes.size(); i++) {
+    if (primes[i] == 2) {
+      twos = exps[i];
+    } else {
+      top = std::max(top, exps[i]);
+    }
+  }
+  while (top >> bits != 0) {
+    bits++;
+  }
+  basic_big_integer res = 1;
+  std::vector<size_t> values;
+  while (bits-- > 0) {
+    values.clear();
+    for (size_t i = 0; i < primes.size(); i++) {
+      if (primes[i] != 2 && (exps[i] >> bits & 1) != 0) {
+        values.push_back(primes[i]);
+      }
+    }
+    res *= res;
+    res *= product_of(values);
+  }
+  res <<= static_cast<int>(twos);
+  return res;
+}
+
+// Legendre: p divides n! sum(n / p^i) times
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::factorial(size_t n) {
+  std::vector<size_t> primes = primes_up_to(n), exps(primes.size());
+  for (size_t i = 0; i < primes.size(); i++) {
+    for (size_t m = n / primes[i]; m != 0; m /= primes[i]) {
+      exps[i] += m;
+    }
+  }
+  return power_product(primes, exps);
+}
+
+// Kummer: p divides n choose k once for each carry when adding k and n - k in base p, which is the difference of
+// the Legendre sums. For k much smaller than n, the sieve up to n would outweigh the result, and the product of
+// n - k + 1 ... n divided by k! is cheaper.
+template <typename Limb, typename Storage>
+basic_big_integer<Limb, Storage> basic_big_integer<Limb, Storage>::binomial(size_t n, size_t k) {
+  if (k > n) {
+    return 0;
+  }
+  k = std::min(k, n - k);
+  if (k < n / 64) {
+    std::vector<size_t> values(k);
+    for (size_t i = 0; i < k; i++) {
+      values[i] = n - i;
+    }
+    return product_of(values) / factorial(k);
+  }
+  std::vector<size_t> primes = primes_up_to(n), exps(primes.size());
+  for (size_t i = 0; i < primes.size(); i++) {
+    size_t p = primes[i];
+    for (size_t q = p;; q *= p) {
+      exps[i] += n / q - k / q - (n - k) / q;
+      if (q > n / p) {
+        break;
+      }
+    }
+  }
+  return power_product(primes, exps);
+}
+
+template <typename Limb, typename Storage>
+basic_montgomery_context<Limb, Storage>::basic_montgomery_context(integer const &modulus)
+    : size_(modulus.data_.size()), modulus_(modulus.sign_ ? -modulus : modulus) {
+  // the inverse below exists only for an odd m; an even one would keep the iteration from ever reaching it
+  if (modulus_.data_[0] % 2 == 0) {
+    throw std::invalid_argument("montgomery_context needs an odd modulus");
+  }
+  // -m^-1 mod BASE: m * m = 1 mod 8 for odd m, and each step x * (2 - m * x) doubles the number of correct bits
+  Limb m0 = modulus_.data_[0], x = m0;
+  while (static_cast<Limb>(m0 * x) != 1) {
+    x *= 2 - m0 * x;
+  }
+  inv_ = static_cast<Limb>(0 - x);
+  r2_ = (integer(1) << static_cast<int>(2 * size_ * integer::BASE)) % modulus_;
+}
+
+template <typename Limb, typename Storage>
+typename basic_montgomery_context<Limb, Storage>::integer const &
+basic_montgomery_context<Limb, Storage>::modulus() const {
+  return modulus_;
+}
+
+template <typename Limb, typename Storage>
+void basic_montgomery_context<Limb, Storage>::load(integer const &a, Limb *res) const {
+  size_t k = a.data_.size();
+  for (size_t i = 0; i < k; i++) {
+    res[i] = a.data_[i];
+  }
+  std::fill(res + k, res + size_, 0);
+}
+
+template <typename Limb, typename Storage>
+typename basic_montgomery_context<Limb, Storage>::integer
+basic_montgomery_context<Limb, Storage>::store(Limb const *a) const {
+  integer res;
+  res.data_.resize(size_);
+  for (size_t i = 0; i < size_; i++) {
+    res.data_[i] = a[i];
+  }
+  res.shrink();
+  return res;
+}
+
+// coarsely integrated operand scanning: row i adds a * b[i] and q * m, with q chosen to clear the low limb, and
+// shifts the sum down by a limb in the same pass; t has n + 2 limbs, the result stays below 2m and loses m at most
+// once, res may alias a or b
+template <typename Limb, typename Storage>
+void basic_montgomery_context<Limb, Storage>::mul_cios(Limb *res, Limb const *a, Limb const *b, Limb *t) const {
+  size_t n = size_;
+  Limb const *m = &modulus_.data_[0];
+  std::fill(t, t + n + 2, 0);
+  for (size_t i = 0; i < n; i++) {
+    double_limb c = 0;
+    for (size_t j = 0; j < n; j++) {
+      c += static_cast<double_limb>(a[j]) * b[i] + t[j];
+      t[j] = static_cast<Limb>(c);
+      c >>= integer::BASE;
+    }
+    c += t[n];
+    t[n] = static_cast<Limb>(c);
+    t[n + 1] = static_cast<Limb>(c >> integer::BASE);
+    Limb q = t[0] * inv_;
+    c = (static_cast<double_limb>(q) * m[0] + t[0]) >> integer::BASE;
+    for (size_t j = 1; j < n; j++) {
+      c += static_cast<double_limb>(q) * m[j] + t[j];
+      t[j - 1] = static_cast<Limb>(c);
+      c >>= integer::BASE;
+    }
+    c += t[n];
+    t[n - 1] = static_cast<Limb>(c);
+    t[n] = t[n + 1] + static_cast<Limb>(c >> integer::BASE);
+  }
+  if (t[n] != 0 || integer::compare_limbs(t, n, m, n) >= 0) {
+    integer::sub_limbs(res, t, n, m, n);
+  } else {
+    std::copy(t, t + n, res);
+  }
+}
+
+// the square counts every cross product once, then each of n rows adds q * m to clear one more low limb; t has
+// 2n + 1 limbs, res may alias a
+template <typename Limb, typename Storage>
+void basic_montgomery_context<Limb, Storage>::sqr_redc(Limb *res, Limb const *a, Limb *t) const {
+  size_t n = size_;
+  Limb const *m = &modulus_.data_[0];
+  integer::sqr_limbs(t, a, n);
+  t[2 * n] = 0;
+  for (size_t i = 0; i < n; i++) {
+    Limb carry = integer::addmul_1(t + i, m, n, t[i] * inv_);
+    for (size_t j = i + n; carry != 0; j++) {
+      t[j] += carry;
+      carry = t[j] < carry;
+    }
+  }
+  Limb *r = t + n;
+  if (r[n] != 0 || integer::compare_limbs(r, n, m, n) >= 0) {
+    integer::sub_limbs(res, r, n, m, n);
+  } else {
+    std::copy(r, r + n, res);
+  }
+}
+
+template <typename Limb, typename Storage>
+typename basic_montgomery_context<Limb, Storage>::integer
+basic_montgomery_context<Limb, Storage>::to_montgomery(integer const &a) const {
+  integer r = a % modulus_;
+  if (r.sign_) {
+    r += modulus_;
+  }
+  return mulmod(r, r2_);
+}
+
+template <typename Limb, typename Storage>
+typename basic_montgomery_context<Limb, Storage>::integer
+basic_montgomery_context<Limb, Storage>::from_montgomery(integer const &a) const {
+  return mulmod(a, 1);
+}
+
+template <typename Limb, typename Storage>
+typename basic_montgomery_context<Limb, Storage>::integer
+basic_montgomery_context<Limb, Storage>::mulmod(integer const &a, integer const &b) const {
+  std::vector<Limb> buf(4 * size_ + 2);
+  Limb *pa = buf.data(), *pb = pa + size_, *t = pb + size_;
+  load(a, pa);
+  load(b, pb);
+  mul_cios(pa, pa, pb, t);
+  return store(pa);
+}
+
+template <typename Limb, typename Storage>
+typename basic_montgomery_context<Limb, Storage>::integer
+basic_montgomery_context<Limb, Storage>::sqrmod(integer const &a) const {
+  std::vector<Limb> buf(3 * size_ + 1);
+  Limb *pa = buf.data(), *t = pa + size_;
+  load(a, pa);
+  sqr_redc(pa, pa, t);
+  return store(pa);
+}
+
+// the exponent is scanned from the top: zero bits square, otherwise the longest window of at most k bits ending
+// in a one is squared in and then multiplied by its odd power from the table
+template <typename Limb, typename Storage>
+typename basic_montgomery_context<Limb, Storage>::integer
+basic_montgomery_context<Limb, Storage>::powmod(integer const &base, integer const &exp) const {
+  size_t n = size_;
+  size_t bits = exp.bit_length();
+  if (bits == 0) {
+    return integer(1) % modulus_;
+  }
+  size_t k = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 7 ? 2 : 1;
+  std::vector<Limb> table((static_cast<size_t>(1) << (k - 1)) * n), acc(n), t(2 * n + 2);
+  load(to_montgomery(base), table.data());
+  if (k > 1) {
+    sqr_redc(acc.data(), table.data(), t.data());
+    for (size_t i = 1; i < (static_cast<size_t>(1) << (k - 1)); i++) {
+      mul_cios(table.data() + i * n, table.data() + (i - 1) * n, acc.data(), t.data());
+    }
+  }
+  auto bit = [&exp](size_t i) {
+    return (exp.data_[i / integer::BASE] >> (i % integer::BASE)) & 1u;
+  };
+  bool started = false;
+  for (size_t i = bits; i > 0;) {
+    if (bit(i - 1) == 0) {
+      sqr_redc(acc.data(), acc.data(), t.data());
+      i--;
+      continue;
+    }
+    size_t low = i > k ? i - k : 0;
+    while (bit(low) == 0) {
+      low++;
+    }
+    size_t value = 0;
+    for (size_t j = i; j > low; j--) {
+      value = value << 1u | bit(j - 1);
+    }
+    Limb const *power = table.data() + (value >> 1u) * n;
+    if (started) {
+      for (size_t j = low; j < i; j++) {
+        sqr_redc(acc.data(), acc.data(), t.data());
+      }
+      mul_cios(acc.data(), acc.data(), power, t.data());
+    } else {
+      std::copy(power, power + n, acc.begin());
+      started = true;
+    }
+    i = low;
+  }
+  std::vector<Limb> one(n);
+  one[0] = 1;
+  mul_cios(acc.data(), acc.data(), one.data(), t.data());
+  return store(acc.data());
+}
+
+template struct basic_big_integer<uint32_t, big_integer_storage<uint32_t>>;
+template struct basic_big_reciprocal<uint32_t, big_integer_storage<uint32_t>>;
+template struct basic_big_divisor<uint32_t, big_integer_storage<uint32_t>>;
+template struct basic_montgomery_context<uint32_t, big_integer_storage<uint32_t>>;
+template struct basic_big_integer<uint64_t, big_integer_storage<uint64_t>>;
+template struct basic_big_reciprocal<uint64_t, big_integer_storage<uint64_t>>;
+template struct basic_big_divisor<uint64_t, big_integer_storage<uint64_t>>;
+template struct basic_montgomery_context<uint64_t, big_integer_storage<uint64_t>>;
+
+#ifdef BIG_INTEGER_SMALL_OBJECT_STORAGE
+// the plain limb_vector policy, so both storages can be benchmarked from one build
+template struct basic_big_integer<uint32_t, limb_vector<uint32_t>>;
+template struct basic_big_reciprocal<uint32_t, limb_vector<uint32_t>>;
+template struct basic_big_divisor<uint32_t, limb_vector<uint32_t>>;
+template struct basic_montgomery_context<uint32_t, limb_vector<uint32_t>>;
+template struct basic_big_integer<uint64_t, limb_vector<uint64_t>>;
+template struct basic_big_reciprocal<uint64_t, limb_vector<uint64_t>>;
+template struct basic_big_divisor<uint64_t, limb_vector<uint64_t>>;
+template struct basic_montgomery_context<uint64_t, limb_vector<uint64_t>>;
+#endif
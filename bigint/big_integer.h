@@ -3,98 +3,603 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <string>
 #include <algorithm>
 #include <cstdint>
 #include <vector>
-#include <functional>
+#include <utility>
+#include <tuple>
 
-struct big_integer
+#include "limb_vector.h"
+#ifdef BIG_INTEGER_SMALL_OBJECT_STORAGE
+#include "small_object_shared_vector.h"
+#endif
+
+#ifndef BIG_INTEGER_KARATSUBA_THRESHOLD
+#define BIG_INTEGER_KARATSUBA_THRESHOLD 32
+#endif
+
+#ifndef BIG_INTEGER_TOOM3_THRESHOLD
+#define BIG_INTEGER_TOOM3_THRESHOLD 128
+#endif
+
+#ifndef BIG_INTEGER_DIV_DC_THRESHOLD
+#define BIG_INTEGER_DIV_DC_THRESHOLD 48
+#endif
+
+#ifndef BIG_INTEGER_NEWTON_THRESHOLD
+#define BIG_INTEGER_NEWTON_THRESHOLD 4096
+#endif
+
+#ifndef BIG_INTEGER_BARRETT_THRESHOLD
+#define BIG_INTEGER_BARRETT_THRESHOLD 16
+#endif
+
+#ifndef BIG_INTEGER_BARRETT_MAX_SIZE
+#define BIG_INTEGER_BARRETT_MAX_SIZE 160
+#endif
+
+#ifndef BIG_INTEGER_HGCD_THRESHOLD
+#define BIG_INTEGER_HGCD_THRESHOLD 128
+#endif
+
+#ifndef BIG_INTEGER_GCD_DC_THRESHOLD
+#define BIG_INTEGER_GCD_DC_THRESHOLD 512
+#endif
+
+#ifndef BIG_INTEGER_RADIX_THRESHOLD
+#define BIG_INTEGER_RADIX_THRESHOLD 32
+#endif
+
+#ifndef BIG_INTEGER_NTT_THRESHOLD
+#define BIG_INTEGER_NTT_THRESHOLD 4096
+#endif
+
+// double-width type for limb products and the largest power of ten that fits into a limb
+template <typename Limb>
+struct big_integer_limb_traits;
+
+template <>
+struct big_integer_limb_traits<uint32_t>
+{
+  using double_limb = uint64_t;
+  constexpr static uint32_t DECIMAL_BASE = 1000000000u;
+  constexpr static size_t DECIMAL_DIGITS = 9;
+};
+
+template <>
+struct big_integer_limb_traits<uint64_t>
 {
-    big_integer();
-    big_integer(big_integer const& other) = default;
-    big_integer(int a);
-    explicit big_integer(std::string const& str);
-    ~big_integer() = default;
+  __extension__ typedef unsigned __int128 double_limb;
+  constexpr static uint64_t DECIMAL_BASE = 10000000000000000000ull;
+  constexpr static size_t DECIMAL_DIGITS = 19;
+};
 
-    big_integer& operator=(big_integer const& other) = default;
+template <typename Limb, typename Storage>
+struct basic_big_reciprocal;
 
-    big_integer& operator+=(big_integer const& rhs);
-    big_integer& operator-=(big_integer const& rhs);
-    big_integer& operator*=(big_integer const& rhs);
-    big_integer& operator/=(big_integer const& rhs);
-    big_integer& operator%=(big_integer const& rhs);
+template <typename Limb, typename Storage>
+struct basic_big_divisor;
 
-    big_integer& operator&=(big_integer const& rhs);
-    big_integer& operator|=(big_integer const& rhs);
-    big_integer& operator^=(big_integer const& rhs);
+template <typename Limb, typename Storage>
+struct basic_montgomery_context;
 
-    big_integer& operator<<=(int rhs);
-    big_integer& operator>>=(int rhs);
+template <typename Limb, typename Storage>
+struct basic_big_product;
 
-    big_integer operator+() const;
-    big_integer operator-() const;
-    big_integer operator~() const;
+template <typename Limb, typename Storage>
+struct basic_big_shift;
 
-    big_integer& operator++();
-    big_integer operator++(int);
+template <size_t Bits, bool Signed>
+struct basic_wide_integer;
 
-    big_integer& operator--();
-    big_integer operator--(int);
+template <typename Limb, typename Storage>
+struct basic_big_integer
+{
+  basic_big_integer();
+  basic_big_integer(basic_big_integer const& other) = default;
+  // the source is left a valid zero without touching the heap: small_object_shared_vector keeps one inline limb
+  // after a move, and an empty limb_vector reads as a single zero limb
+  basic_big_integer(basic_big_integer&& other) noexcept : sign_(other.sign_), data_(std::move(other.data_)) {
+    other.sign_ = false;
+  }
+  basic_big_integer(int a);
+  explicit basic_big_integer(std::string const& str);
+  ~basic_big_integer() = default;
 
-    friend bool operator==(big_integer const& a, big_integer const& b);
-    friend bool operator!=(big_integer const& a, big_integer const& b);
-    friend bool operator<(big_integer const& a, big_integer const& b);
-    friend bool operator>(big_integer const& a, big_integer const& b);
-    friend bool operator<=(big_integer const& a, big_integer const& b);
-    friend bool operator>=(big_integer const& a, big_integer const& b);
+  basic_big_integer& operator=(basic_big_integer const& other) = default;
+  basic_big_integer& operator=(basic_big_integer&& other) noexcept {
+    data_.swap(other.data_);
+    std::swap(sign_, other.sign_);
+    return *this;
+  }
 
-    friend std::string to_string(big_integer const& a);
+  basic_big_integer& operator+=(basic_big_integer const& rhs);
+  basic_big_integer& operator-=(basic_big_integer const& rhs);
+  basic_big_integer& operator*=(basic_big_integer const& rhs);
+  basic_big_integer& operator/=(basic_big_integer const& rhs);
+  basic_big_integer& operator%=(basic_big_integer const& rhs);
 
-private:
-  using double_data_type = uint64_t;
-  using storage = std::vector<uint32_t>;
+  basic_big_integer& operator&=(basic_big_integer const& rhs);
+  basic_big_integer& operator|=(basic_big_integer const& rhs);
+  basic_big_integer& operator^=(basic_big_integer const& rhs);
+
+  basic_big_integer& operator<<=(int rhs);
+  basic_big_integer& operator>>=(int rhs);
+
+  // acc += mul(a, b) and acc -= mul(a, b) fold the product into acc row by row, acc += shl(a, k) adds the shifted
+  // limbs on the fly, in both cases without storing the intermediate value
+  basic_big_integer& operator+=(basic_big_product<Limb, Storage> const& rhs);
+  basic_big_integer& operator-=(basic_big_product<Limb, Storage> const& rhs);
+  basic_big_integer& operator+=(basic_big_shift<Limb, Storage> const& rhs);
+  basic_big_integer& operator-=(basic_big_shift<Limb, Storage> const& rhs);
+
+  basic_big_integer operator+() const;
+  basic_big_integer operator-() const &;
+  basic_big_integer operator-() &&;
+  basic_big_integer operator~() const;
+
+  basic_big_integer& operator++();
+  basic_big_integer operator++(int);
+
+  basic_big_integer& operator--();
+  basic_big_integer operator--(int);
+
+  // n! and the binomial coefficient n choose k, zero for k > n, both from the prime factorization
+  static basic_big_integer factorial(size_t n);
+  static basic_big_integer binomial(size_t n, size_t k);
+
+  // the result is built in the left operand taken by value, or in an rvalue right operand where the operation allows,
+  // so a chain like a + b + c works in a single buffer
+  friend basic_big_integer operator+(basic_big_integer a, basic_big_integer const& b) {
+    a += b;
+    return a;
+  }
+  friend basic_big_integer operator+(basic_big_integer const& a, basic_big_integer&& b) {
+    b += a;
+    return std::move(b);
+  }
+  friend basic_big_integer operator-(basic_big_integer a, basic_big_integer const& b) {
+    a -= b;
+    return a;
+  }
+  friend basic_big_integer operator-(basic_big_integer const& a, basic_big_integer&& b) {
+    b -= a;
+    b.negate();
+    return std::move(b);
+  }
+  friend basic_big_integer operator*(basic_big_integer a, basic_big_integer const& b) {
+    a *= b;
+    return a;
+  }
+  friend basic_big_integer operator*(basic_big_integer const& a, basic_big_integer&& b) {
+    b *= a;
+    return std::move(b);
+  }
+  friend basic_big_integer operator/(basic_big_integer a, basic_big_integer const& b) {
+    a /= b;
+    return a;
+  }
+  friend basic_big_integer operator%(basic_big_integer a, basic_big_integer const& b) {
+    a %= b;
+    return a;
+  }
+  // quotient and remainder of a single division, rounded like / and %
+  friend std::pair<basic_big_integer, basic_big_integer> divmod(basic_big_integer const& a,
+                                                                basic_big_integer const& b) {
+    return divide(a, b);
+  }
+  // base^exp mod |mod| in [0, |mod|) for exp >= 0, through Montgomery multiplication when mod is odd
+  friend basic_big_integer powmod(basic_big_integer const& base, basic_big_integer const& exp,
+                                  basic_big_integer const& mod) {
+    return power_mod(base, exp, mod);
+  }
+  // greatest common divisor of |a| and |b|, gcd(0, 0) = 0
+  friend basic_big_integer gcd(basic_big_integer const& a, basic_big_integer const& b) {
+    return common_divisor(a, b);
+  }
+  // least common multiple of |a| and |b|, zero if either of them is zero
+  friend basic_big_integer lcm(basic_big_integer const& a, basic_big_integer const& b) {
+    return common_multiple(a, b);
+  }
+  // g = gcd(a, b) and a * x + b * y = g, with 0 <= x < |b| / g unless b is zero
+  friend std::tuple<basic_big_integer, basic_big_integer, basic_big_integer> xgcd(basic_big_integer const& a,
+                                                                                   basic_big_integer const& b) {
+    return extended_gcd(a, b);
+  }
+  // a^-1 mod |m| in [0, |m|) for m != 0, zero if a and m are not coprime
+  friend basic_big_integer modinv(basic_big_integer const& a, basic_big_integer const& m) {
+    return inverse_mod(a, m);
+  }
+  // floor(sqrt(a)) for a >= 0
+  friend basic_big_integer isqrt(basic_big_integer const& a) {
+    return root(a, 2);
+  }
+  // the k-th root of a rounded toward zero, for k >= 1 and either a >= 0 or an odd k
+  friend basic_big_integer iroot(basic_big_integer const& a, size_t k) {
+    return root(a, k);
+  }
+  // whether a = x^k for some integers x and k >= 2, which includes 0, 1 and -1
+  friend bool is_perfect_power(basic_big_integer const& a) {
+    return perfect_power(a);
+  }
+  // a^e with 0^0 = 1
+  friend basic_big_integer pow(basic_big_integer const& a, size_t e) {
+    return power(a, e);
+  }
+  // the product of all factors, 1 if there are none, multiplied along a tree balanced by size
+  friend basic_big_integer product(std::vector<basic_big_integer> const& factors) {
+    return product_tree(factors);
+  }
+
+  friend basic_big_integer operator&(basic_big_integer a, basic_big_integer const& b) {
+    a &= b;
+    return a;
+  }
+  friend basic_big_integer operator&(basic_big_integer const& a, basic_big_integer&& b) {
+    b &= a;
+    return std::move(b);
+  }
+  friend basic_big_integer operator|(basic_big_integer a, basic_big_integer const& b) {
+    a |= b;
+    return a;
+  }
+  friend basic_big_integer operator|(basic_big_integer const& a, basic_big_integer&& b) {
+    b |= a;
+    return std::move(b);
+  }
+  friend basic_big_integer operator^(basic_big_integer a, basic_big_integer const& b) {
+    a ^= b;
+    return a;
+  }
+  friend basic_big_integer operator^(basic_big_integer const& a, basic_big_integer&& b) {
+    b ^= a;
+    return std::move(b);
+  }
+
+  friend basic_big_integer operator<<(basic_big_integer a, int b) {
+    a <<= b;
+    return a;
+  }
+  friend basic_big_integer operator>>(basic_big_integer a, int b) {
+    a >>= b;
+    return a;
+  }
+
+  friend bool operator==(basic_big_integer const& a, basic_big_integer const& b) {
+    return compare(a, b) == 0;
+  }
+  friend bool operator!=(basic_big_integer const& a, basic_big_integer const& b) {
+    return compare(a, b) != 0;
+  }
+  friend bool operator<(basic_big_integer const& a, basic_big_integer const& b) {
+    return compare(a, b) < 0;
+  }
+  friend bool operator>(basic_big_integer const& a, basic_big_integer const& b) {
+    return compare(a, b) > 0;
+  }
+  friend bool operator<=(basic_big_integer const& a, basic_big_integer const& b) {
+    return compare(a, b) <= 0;
+  }
+  friend bool operator>=(basic_big_integer const& a, basic_big_integer const& b) {
+    return compare(a, b) >= 0;
+  }
+
+  // lazy a * b and a << shift, the operands are referenced until the end of the full expression
+  friend basic_big_product<Limb, Storage> mul(basic_big_integer const& a, basic_big_integer const& b) {
+    return {a, b};
+  }
+  friend basic_big_shift<Limb, Storage> shl(basic_big_integer const& a, int shift) {
+    return {a, shift};
+  }
+
+  friend std::string to_string(basic_big_integer const& a) {
+    return to_decimal(a);
+  }
+  friend std::ostream& operator<<(std::ostream& s, basic_big_integer const& a) {
+    return print(s, a);
+  }
+
+  friend struct basic_big_reciprocal<Limb, Storage>;
+  friend struct basic_big_divisor<Limb, Storage>;
+  friend struct basic_montgomery_context<Limb, Storage>;
+  template <size_t Bits, bool Signed>
+  friend struct basic_wide_integer;
+
+ private:
+  using double_limb = typename big_integer_limb_traits<Limb>::double_limb;
   bool sign_;
-  storage data_;
-  constexpr static uint32_t MAX_VALUE = UINT32_MAX;
-  constexpr static uint32_t BASE = 32;
-  constexpr static uint64_t FULL_DIGIT = (1ULL << 32u);
-  static bool overflow_add(uint32_t a, uint32_t b, bool carry);
+  Storage data_;
+  constexpr static Limb MAX_VALUE = ~static_cast<Limb>(0);
+  constexpr static uint32_t BASE = 8 * sizeof(Limb);
+  constexpr static size_t KARATSUBA_THRESHOLD = BIG_INTEGER_KARATSUBA_THRESHOLD;
+  constexpr static size_t TOOM3_THRESHOLD = BIG_INTEGER_TOOM3_THRESHOLD;
+  constexpr static size_t DIV_DC_THRESHOLD = BIG_INTEGER_DIV_DC_THRESHOLD;
+  constexpr static size_t NEWTON_THRESHOLD = BIG_INTEGER_NEWTON_THRESHOLD;
+  constexpr static size_t BARRETT_THRESHOLD = BIG_INTEGER_BARRETT_THRESHOLD;
+  constexpr static size_t BARRETT_MAX_SIZE = BIG_INTEGER_BARRETT_MAX_SIZE;
+  constexpr static size_t HGCD_THRESHOLD = BIG_INTEGER_HGCD_THRESHOLD;
+  constexpr static size_t GCD_DC_THRESHOLD = BIG_INTEGER_GCD_DC_THRESHOLD;
+  constexpr static size_t NTT_THRESHOLD = BIG_INTEGER_NTT_THRESHOLD;
+  constexpr static size_t RADIX_THRESHOLD = BIG_INTEGER_RADIX_THRESHOLD;
+  constexpr static Limb DECIMAL_BASE = big_integer_limb_traits<Limb>::DECIMAL_BASE;
+  constexpr static size_t DECIMAL_DIGITS = big_integer_limb_traits<Limb>::DECIMAL_DIGITS;
+  // the transform works on 32-bit pieces, at most 2^24 of them
+  constexpr static size_t NTT_MAX_SIZE = (1u << 24u) / (sizeof(Limb) / sizeof(uint32_t));
+  static_assert(KARATSUBA_THRESHOLD >= 4, "karatsuba halves must be smaller than its operands");
+  static_assert(TOOM3_THRESHOLD >= 6, "toom-3 thirds must be smaller than its operands");
+  static_assert(DIV_DC_THRESHOLD >= 4, "divide and conquer halves must be at least two limbs long");
+  static_assert(NEWTON_THRESHOLD >= 8, "newton iteration must shrink the divisor it inverts");
+  static_assert(BARRETT_THRESHOLD >= 2, "single-limb divisors are left to div_1");
+  static_assert(BARRETT_MAX_SIZE >= BARRETT_THRESHOLD, "the barrett range must not be empty");
+  static_assert(HGCD_THRESHOLD >= 8, "half-gcd halves must be long enough for Lehmer steps");
+  static_assert(RADIX_THRESHOLD >= 3, "radix conversion leaves must hold DECIMAL_BASE^2");
+  static basic_big_integer from_limb(Limb x);
+  static basic_big_integer from_double_limb(double_limb x);
   void shrink();
-  static int compare_abs(big_integer const &a, big_integer const &b);
-  static uint32_t simple_overflow(uint64_t);
-  static big_integer to_complementary(big_integer const &a);
-  static big_integer product(big_integer y, uint32_t k);
-  static big_integer quotient(big_integer y, uint32_t k);
-  static uint32_t remainder(big_integer y, uint32_t k);
-  static uint32_t trial(uint64_t a, uint64_t b, uint64_t c);
-  static bool smaller(big_integer &r, big_integer &dq, uint32_t k, uint32_t m);
-  static void difference(big_integer &r, big_integer &dq, uint32_t k, uint32_t m);
-
-  big_integer& bitwise(big_integer const& rhs,
-                                const std::function<uint32_t(uint32_t, uint32_t)>& f);
+  basic_big_integer& shift_left(size_t rhs);
+  basic_big_integer& shift_right(size_t rhs);
+  void negate();
+  static int compare_abs(basic_big_integer const &a, basic_big_integer const &b);
+  static int compare(basic_big_integer const &a, basic_big_integer const &b);
+  static Limb simple_overflow(double_limb);
+  static uint32_t leading_zeros(Limb x);
+  size_t bit_length() const;
+  size_t low_zero_bits() const;
+
+  static size_t significant(Limb const *a, size_t n);
+  static int compare_limbs(Limb const *a, size_t n, Limb const *b, size_t m);
+  static Limb add_limbs(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m);
+  static Limb sub_limbs(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m);
+  static Limb addmul_1(Limb *res, Limb const *a, size_t n, Limb k);
+  static Limb submul_1(Limb *res, Limb const *a, size_t n, Limb k);
+  static Limb mul_1(Limb *res, Limb const *a, size_t n, Limb k);
+  static Limb addmul_limbs(Limb *res, size_t size, Limb const *a, size_t n, Limb const *b, size_t m);
+  static Limb submul_limbs(Limb *res, size_t size, Limb const *a, size_t n, Limb const *b, size_t m);
+  static Limb addshl_limbs(Limb *res, size_t size, Limb const *a, size_t n, uint32_t shift);
+  static Limb subshl_limbs(Limb *res, size_t size, Limb const *a, size_t n, uint32_t shift);
+  static Limb div_1(Limb *res, Limb const *a, size_t n, Limb k);
+  static void shr_limbs(Limb *res, Limb const *a, size_t n, uint32_t shift);
+  static Limb shl_limbs(Limb *res, Limb const *a, size_t n, uint32_t shift);
+  static void mul_basecase(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m);
+  static void mul_unbalanced(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m);
+  static void mul_karatsuba(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m);
+  static bool toom3_evaluate(Limb const *a, size_t k, size_t n2, Limb *e1, Limb *em1, Limb *e2);
+  static void toom3_interpolate(Limb *res, size_t size, size_t k, Limb *v1, Limb *vm1, Limb *v2, bool negative);
+  static void mul_toom3(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m);
+  static void mul_limbs(Limb *res, Limb const *a, size_t n, Limb const *b, size_t m);
+  static void sqr_basecase(Limb *res, Limb const *a, size_t n);
+  static void sqr_karatsuba(Limb *res, Limb const *a, size_t n);
+  static void sqr_toom3(Limb *res, Limb const *a, size_t n);
+  static void sqr_limbs(Limb *res, Limb const *a, size_t n);
+  static Limb div_basecase(Limb *q, Limb *a, size_t n, Limb const *d, size_t m);
+  static Limb div_dc_n(Limb *q, Limb *a, Limb const *d, size_t m);
+  static void div_limbs(Limb *q, Limb *a, size_t n, Limb const *d, size_t m);
+  static bool use_reciprocal(basic_big_integer const &a, basic_big_integer const &b);
+  static std::pair<basic_big_integer, basic_big_integer> divide(basic_big_integer const &a,
+                                                                basic_big_integer const &b);
+  static basic_big_integer power_mod(basic_big_integer const &base, basic_big_integer const &exp,
+                                     basic_big_integer const &mod);
+  static uint32_t trailing_zeros(double_limb x);
+  static double_limb binary_gcd(double_limb a, double_limb b);
+  static bool combine(basic_big_integer &res, basic_big_integer const &a, basic_big_integer const &b, Limb p, Limb q,
+                      bool add);
+  static void combine_signed(basic_big_integer &res, basic_big_integer const &a, basic_big_integer const &b, Limb p,
+                             Limb q, bool negate);
+  static bool gcd_step(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m, size_t s);
+  static void gcd_compose(basic_big_integer *m, basic_big_integer const *t);
+  static bool gcd_lift(basic_big_integer &a, basic_big_integer &b, size_t p, basic_big_integer *m);
+  static bool half_gcd(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m);
+  static void gcd_tail(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m);
+  static void gcd_reduce(basic_big_integer &a, basic_big_integer &b, basic_big_integer *m);
+  static basic_big_integer common_divisor(basic_big_integer const &a, basic_big_integer const &b);
+  static basic_big_integer common_multiple(basic_big_integer const &a, basic_big_integer const &b);
+  static std::tuple<basic_big_integer, basic_big_integer, basic_big_integer> extended_gcd(basic_big_integer const &a,
+                                                                                         basic_big_integer const &b);
+  static basic_big_integer inverse_mod(basic_big_integer const &a, basic_big_integer const &mod);
+  static basic_big_integer power(basic_big_integer const &x, size_t e);
+  static double leading_bits(basic_big_integer const &a, size_t &shift);
+  static double root_estimate(double top, size_t shift, size_t k);
+  static basic_big_integer root(basic_big_integer const &a, size_t k);
+  static bool power_residue(basic_big_integer const &a, size_t p);
+  static bool perfect_power(basic_big_integer const &a);
+  static std::vector<size_t> primes_up_to(size_t n);
+  static basic_big_integer product_tree(std::vector<basic_big_integer> const &factors);
+  static basic_big_integer product_range(std::vector<basic_big_integer> const &factors,
+                                         std::vector<size_t> const &sizes, size_t first, size_t last);
+  static basic_big_integer product_of(std::vector<size_t> const &values);
+  static basic_big_integer power_product(std::vector<size_t> const &primes, std::vector<size_t> const &exps);
+  static size_t decimal_split(size_t len);
+  static std::vector<basic_big_integer> const &decimal_powers(size_t k);
+  static basic_big_integer read_decimal(char const *s, size_t len, std::vector<basic_big_integer> const &powers);
+  static void write_decimal(char *out, basic_big_integer const &x, std::vector<basic_big_integer> const &powers,
+                            size_t k);
+  static std::string to_decimal(basic_big_integer const &a);
+  static std::ostream &print(std::ostream &s, basic_big_integer const &a);
+
+  basic_big_integer& add_signed(Limb const *b, size_t m, bool b_sign);
+  basic_big_integer& add_product(basic_big_integer const& a, basic_big_integer const& b, bool negate);
+  basic_big_integer& add_shift(basic_big_integer const& a, int shift, bool negate);
+  template <typename Kernel>
+  basic_big_integer& accumulate(size_t size, bool rhs_sign, Kernel kernel);
+  template <typename Op>
+  basic_big_integer& bitwise(basic_big_integer const& rhs, Op op);
 };
 
-big_integer operator+(big_integer a, big_integer const& b);
-big_integer operator-(big_integer a, big_integer const& b);
-big_integer operator*(big_integer a, big_integer const& b);
-big_integer operator/(big_integer a, big_integer const& b);
-big_integer operator%(big_integer a, big_integer const& b);
+// a * b waiting to be added to or subtracted from another value, see mul
+template <typename Limb, typename Storage>
+struct basic_big_product
+{
+  using integer = basic_big_integer<Limb, Storage>;
+
+  integer const& a;
+  integer const& b;
+
+  operator integer() const {
+    return a * b;
+  }
+
+  friend integer operator+(integer c, basic_big_product const& p) {
+    c += p;
+    return c;
+  }
+  friend integer operator+(basic_big_product const& p, integer c) {
+    c += p;
+    return c;
+  }
+  friend integer operator-(integer c, basic_big_product const& p) {
+    c -= p;
+    return c;
+  }
+  friend integer operator-(basic_big_product const& p, integer const& c) {
+    integer r = p;
+    r -= c;
+    return r;
+  }
+  friend integer operator+(basic_big_product const& p, basic_big_product const& q) {
+    integer r = p;
+    r += q;
+    return r;
+  }
+  friend integer operator-(basic_big_product const& p, basic_big_product const& q) {
+    integer r = p;
+    r -= q;
+    return r;
+  }
+};
+
+// a << shift waiting to be added to or subtracted from another value, see shl
+template <typename Limb, typename Storage>
+struct basic_big_shift
+{
+  using integer = basic_big_integer<Limb, Storage>;
+
+  integer const& a;
+  int shift;
+
+  operator integer() const {
+    return a << shift;
+  }
+
+  friend integer operator+(integer c, basic_big_shift const& s) {
+    c += s;
+    return c;
+  }
+  friend integer operator+(basic_big_shift const& s, integer c) {
+    c += s;
+    return c;
+  }
+  friend integer operator-(integer c, basic_big_shift const& s) {
+    c -= s;
+    return c;
+  }
+};
+
+// divides many numbers by the same divisor with a precomputed Newton inverse
+template <typename Limb, typename Storage>
+struct basic_big_reciprocal
+{
+  using integer = basic_big_integer<Limb, Storage>;
+
+  explicit basic_big_reciprocal(integer const& divisor);
+
+  integer quotient(integer const& a) const;
+  integer remainder(integer const& a) const;
+  std::pair<integer, integer> divmod(integer const& a) const;
+
+ private:
+  bool sign_;
+  uint32_t shift_;
+  size_t size_;
+  integer divisor_;
+  integer inverse_;
 
-big_integer operator&(big_integer a, big_integer const& b);
-big_integer operator|(big_integer a, big_integer const& b);
-big_integer operator^(big_integer a, big_integer const& b);
+  static integer invert(integer const& d, size_t m);
+  void divide(integer const& a, integer& q, integer& r) const;
+};
+
+// divides many dividends by the same divisor: the divisor is normalized once and, from BARRETT_THRESHOLD up to
+// BARRETT_MAX_SIZE limbs, gets the Barrett reciprocal mu = BASE^(2k) / d, so that a dividend of at most 2k limbs costs
+// two truncated schoolbook products and at most three corrections. Measured on 2k by k remainders, the truncated
+// products stay ahead of the long division well past KARATSUBA_THRESHOLD (16.4 against 18.6 us at 128 32-bit limbs,
+// 5.3 against 7.0 us at 160 64-bit ones) and 32-bit limbs cross over near 190; full products on the subquadratic
+// tiers compute twice the columns; they tied with the long division at 32 limbs and fell behind it up to 512. Larger
+// divisors, like longer dividends, run the long division on the kept divisor
+template <typename Limb, typename Storage>
+struct basic_big_divisor
+{
+  using integer = basic_big_integer<Limb, Storage>;
+
+  explicit basic_big_divisor(integer const& divisor);
+
+  integer div(integer const& a) const;
+  integer mod(integer const& a) const;
+  std::pair<integer, integer> divmod(integer const& a) const;
+
+ private:
+  bool sign_;
+  uint32_t shift_;
+  size_t size_;
+  std::vector<Limb> divisor_;
+  std::vector<Limb> mu_;
+
+  void barrett(Limb *q, Limb *a) const;
+};
+
+// arithmetic modulo an odd m on values in Montgomery form x * R mod m, R = BASE^n for the n limbs of m: a product
+// is reduced by adding multiples of m that clear its low limbs instead of dividing by m
+template <typename Limb, typename Storage>
+struct basic_montgomery_context
+{
+  using integer = basic_big_integer<Limb, Storage>;
+
+  // throws std::invalid_argument for an even or zero modulus
+  explicit basic_montgomery_context(integer const& modulus);
+
+  integer const& modulus() const;
+  // a * R mod m for any a, and back
+  integer to_montgomery(integer const& a) const;
+  integer from_montgomery(integer const& a) const;
+  // a * b / R mod m for a, b in [0, m), so Montgomery forms multiply into the Montgomery form of the product
+  integer mulmod(integer const& a, integer const& b) const;
+  integer sqrmod(integer const& a) const;
+  // base^exp mod m for an ordinary base and exp >= 0, by sliding windows of odd powers
+  integer powmod(integer const& base, integer const& exp) const;
+
+ private:
+  using double_limb = typename integer::double_limb;
+  size_t size_;
+  Limb inv_;
+  integer modulus_;
+  integer r2_;
+
+  void load(integer const& a, Limb *res) const;
+  integer store(Limb const *a) const;
+  void mul_cios(Limb *res, Limb const *a, Limb const *b, Limb *t) const;
+  void sqr_redc(Limb *res, Limb const *a, Limb *t) const;
+};
 
-big_integer operator<<(big_integer a, int b);
-big_integer operator>>(big_integer a, int b);
+// bigint-optimized builds these same sources with BIG_INTEGER_SMALL_OBJECT_STORAGE defined; the storage policy
+// is the only thing that differs between the two directories
+#ifdef BIG_INTEGER_SMALL_OBJECT_STORAGE
+template <typename Limb>
+using big_integer_storage = small_object_shared_vector<Limb>;
+#else
+template <typename Limb>
+using big_integer_storage = limb_vector<Limb>;
+#endif
 
-bool operator==(big_integer const& a, big_integer const& b);
-bool operator!=(big_integer const& a, big_integer const& b);
-bool operator<(big_integer const& a, big_integer const& b);
-bool operator>(big_integer const& a, big_integer const& b);
-bool operator<=(big_integer const& a, big_integer const& b);
-bool operator>=(big_integer const& a, big_integer const& b);
+using big_integer = basic_big_integer<uint32_t, big_integer_storage<uint32_t>>;
+using big_reciprocal = basic_big_reciprocal<uint32_t, big_integer_storage<uint32_t>>;
+using big_divisor = basic_big_divisor<uint32_t, big_integer_storage<uint32_t>>;
+using montgomery_context = basic_montgomery_context<uint32_t, big_integer_storage<uint32_t>>;
 
-std::string to_string(big_integer const& a);
-std::ostream& operator<<(std::ostream& s, big_integer const& a);
+// half the limbs and loop trips of big_integer, with unsigned __int128 for the double-width products. Only 64-bit
+// limbs get the BMI2/ADX kernels on x86-64 and big_integer always runs the portable loops, so this is the type to use
+// for speed
+using big_integer64 = basic_big_integer<uint64_t, big_integer_storage<uint64_t>>;
+using big_reciprocal64 = basic_big_reciprocal<uint64_t, big_integer_storage<uint64_t>>;
+using big_divisor64 = basic_big_divisor<uint64_t, big_integer_storage<uint64_t>>;
+using montgomery_context64 = basic_montgomery_context<uint64_t, big_integer_storage<uint64_t>>;
 
 #endif // BIG_INTEGER_H
@@ -159,6 +159,66 @@ big_integer_gmp operator>>(big_integer_gmp a, int b) {
   return a >>= b;
 }
 
+big_integer_gmp powmod(big_integer_gmp const& base, big_integer_gmp const& exp, big_integer_gmp const& mod) {
+  big_integer_gmp res;
+  mpz_powm(res.mpz, base.mpz, exp.mpz, mod.mpz);
+  return res;
+}
+
+big_integer_gmp gcd(big_integer_gmp const& a, big_integer_gmp const& b) {
+  big_integer_gmp res;
+  mpz_gcd(res.mpz, a.mpz, b.mpz);
+  return res;
+}
+
+big_integer_gmp lcm(big_integer_gmp const& a, big_integer_gmp const& b) {
+  big_integer_gmp res;
+  mpz_lcm(res.mpz, a.mpz, b.mpz);
+  return res;
+}
+
+big_integer_gmp modinv(big_integer_gmp const& a, big_integer_gmp const& m) {
+  big_integer_gmp res;
+  if (mpz_invert(res.mpz, a.mpz, m.mpz) == 0) {
+    mpz_set_ui(res.mpz, 0);
+  }
+  return res;
+}
+
+big_integer_gmp isqrt(big_integer_gmp const& a) {
+  big_integer_gmp res;
+  mpz_sqrt(res.mpz, a.mpz);
+  return res;
+}
+
+big_integer_gmp iroot(big_integer_gmp const& a, size_t k) {
+  big_integer_gmp res;
+  mpz_root(res.mpz, a.mpz, k);
+  return res;
+}
+
+bool is_perfect_power(big_integer_gmp const& a) {
+  return mpz_perfect_power_p(a.mpz) != 0;
+}
+
+big_integer_gmp pow(big_integer_gmp const& a, size_t e) {
+  big_integer_gmp res;
+  mpz_pow_ui(res.mpz, a.mpz, e);
+  return res;
+}
+
+big_integer_gmp big_integer_gmp::factorial(size_t n) {
+  big_integer_gmp res;
+  mpz_fac_ui(res.mpz, n);
+  return res;
+}
+
+big_integer_gmp big_integer_gmp::binomial(size_t n, size_t k) {
+  big_integer_gmp res;
+  mpz_bin_uiui(res.mpz, n, k);
+  return res;
+}
+
 bool operator==(big_integer_gmp const& a, big_integer_gmp const& b) {
   return mpz_cmp(a.mpz, b.mpz) == 0;
 }
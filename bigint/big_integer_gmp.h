@@ -51,6 +51,9 @@ struct big_integer_gmp {
   big_integer_gmp& operator--();
   big_integer_gmp operator--(int);
 
+  static big_integer_gmp factorial(size_t n);
+  static big_integer_gmp binomial(size_t n, size_t k);
+
   friend bool operator==(big_integer_gmp const& a, big_integer_gmp const& b);
   friend bool operator!=(big_integer_gmp const& a, big_integer_gmp const& b);
   friend bool operator<(big_integer_gmp const& a, big_integer_gmp const& b);
@@ -58,6 +61,15 @@ struct big_integer_gmp {
   friend bool operator<=(big_integer_gmp const& a, big_integer_gmp const& b);
   friend bool operator>=(big_integer_gmp const& a, big_integer_gmp const& b);
 
+  friend big_integer_gmp powmod(big_integer_gmp const& base, big_integer_gmp const& exp, big_integer_gmp const& mod);
+  friend big_integer_gmp gcd(big_integer_gmp const& a, big_integer_gmp const& b);
+  friend big_integer_gmp lcm(big_integer_gmp const& a, big_integer_gmp const& b);
+  friend big_integer_gmp modinv(big_integer_gmp const& a, big_integer_gmp const& m);
+  friend big_integer_gmp isqrt(big_integer_gmp const& a);
+  friend big_integer_gmp iroot(big_integer_gmp const& a, size_t k);
+  friend bool is_perfect_power(big_integer_gmp const& a);
+  friend big_integer_gmp pow(big_integer_gmp const& a, size_t e);
+
   friend std::string to_string(big_integer_gmp const& a);
 
  private:
@@ -77,6 +89,15 @@ big_integer_gmp operator^(big_integer_gmp a, big_integer_gmp const& b);
 big_integer_gmp operator<<(big_integer_gmp a, int b);
 big_integer_gmp operator>>(big_integer_gmp a, int b);
 
+big_integer_gmp powmod(big_integer_gmp const& base, big_integer_gmp const& exp, big_integer_gmp const& mod);
+big_integer_gmp gcd(big_integer_gmp const& a, big_integer_gmp const& b);
+big_integer_gmp lcm(big_integer_gmp const& a, big_integer_gmp const& b);
+big_integer_gmp modinv(big_integer_gmp const& a, big_integer_gmp const& m);
+big_integer_gmp isqrt(big_integer_gmp const& a);
+big_integer_gmp iroot(big_integer_gmp const& a, size_t k);
+bool is_perfect_power(big_integer_gmp const& a);
+big_integer_gmp pow(big_integer_gmp const& a, size_t e);
+
 bool operator==(big_integer_gmp const& a, big_integer_gmp const& b);
 bool operator!=(big_integer_gmp const& a, big_integer_gmp const& b);
 bool operator<(big_integer_gmp const& a, big_integer_gmp const& b);
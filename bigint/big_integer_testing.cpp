@@ -2,11 +2,14 @@
 #include <cassert>
 #include <cstdlib>
 #include <random>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 #include <utility>
 #include <gtest/gtest.h>
 
 #include "big_integer.h"
+#include "wide_integer.h"
 #include "big_integer_gmp.h"
 
 TEST(correctness, two_plus_two) {
@@ -76,6 +79,77 @@ TEST(correctness, assignment_return_value) {
   EXPECT_TRUE(b == 7);
 }
 
+TEST(correctness, move_ctor_and_assignment) {
+  static_assert(std::is_nothrow_move_constructible<big_integer>::value, "vector growth must move big_integer");
+  static_assert(std::is_nothrow_move_assignable<big_integer>::value, "moves must not throw");
+  big_integer a("-123456789012345678901234567890");
+  big_integer b = 7;
+  big_integer c(std::move(a));
+  EXPECT_EQ(c, big_integer("-123456789012345678901234567890"));
+
+  a = std::move(b);
+  EXPECT_EQ(a, 7);
+  b = c;
+  c = 3;
+  EXPECT_EQ(b, big_integer("-123456789012345678901234567890"));
+
+  std::vector<big_integer> v;
+  for (int i = 0; i < 100; i++) {
+    v.push_back(b * i);
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(v[i], b * i);
+  }
+}
+
+TEST(correctness, moved_from_is_valid) {
+  big_integer a("-123456789012345678901234567890");
+  big_integer b(std::move(a));
+  EXPECT_EQ(to_string(a), "0");
+  EXPECT_EQ(a, 0);
+  a += 5;
+  EXPECT_EQ(a, 5);
+
+  big_integer c = -7;
+  big_integer d(std::move(c));
+  EXPECT_EQ(d, -7);
+  EXPECT_EQ(c * 2 - c, c);
+
+  big_integer &alias = b;
+  b = std::move(alias);
+  EXPECT_EQ(to_string(b), "-123456789012345678901234567890");
+  a = std::move(b);
+  EXPECT_EQ(to_string(b), to_string(b + 0));
+  EXPECT_EQ(a, big_integer("-123456789012345678901234567890"));
+
+  big_integer64 e = big_integer64(1) << 200;
+  big_integer64 f(std::move(e));
+  EXPECT_EQ(e, 0);
+  EXPECT_EQ(f >> 200, 1);
+  e -= f;
+  EXPECT_EQ(e, -f);
+  big_integer64 g(std::move(f));
+  f *= g;
+  f |= big_integer64(1) << 70;
+  EXPECT_EQ(f, big_integer64(1) << 70);
+}
+
+TEST(correctness, rvalue_operands) {
+  big_integer a("123456789012345678901234567890");
+  big_integer b = -5;
+
+  EXPECT_EQ(a - (b * b), big_integer("123456789012345678901234567865"));
+  EXPECT_EQ(b - (a * 2), big_integer("-246913578024691357802469135785"));
+  EXPECT_EQ(b + (a + 0), big_integer("123456789012345678901234567885"));
+  EXPECT_EQ(b * (a + 0), big_integer("-617283945061728394506172839450"));
+  EXPECT_EQ(b & (a + 0), a & b);
+  EXPECT_EQ(b | (a + 0), a | b);
+  EXPECT_EQ(b ^ (a + 0), a ^ b);
+  EXPECT_EQ(a - (a + 0), 0);
+  EXPECT_EQ(-(a * b), big_integer("617283945061728394506172839450"));
+  EXPECT_EQ(to_string(-(a - a)), "0");
+}
+
 TEST(correctness, comparisons) {
   big_integer a = 100;
   big_integer b = 100;
@@ -158,6 +232,26 @@ TEST(correctness, sub_return_value) {
   EXPECT_EQ(3, a);
 }
 
+TEST(correctness, add_sub_self) {
+  big_integer a("-123456789012345678901234567890");
+
+  a += a;
+  EXPECT_EQ(a, big_integer("-246913578024691357802469135780"));
+
+  a -= a;
+  EXPECT_EQ(a, 0);
+  EXPECT_EQ(to_string(a), "0");
+
+  big_integer b("4294967296");
+  big_integer c = -b;
+  c += b;
+  EXPECT_EQ(to_string(c), "0");
+  b -= big_integer("-18446744073709551616");
+  EXPECT_EQ(b, big_integer("18446744078004518912"));
+  b += big_integer("-18446744078004518913");
+  EXPECT_EQ(b, -1);
+}
+
 TEST(correctness, mul) {
   big_integer a = 5;
   big_integer b = 20;
@@ -422,6 +516,20 @@ TEST(correctness, shr_signed) {
   EXPECT_EQ(-155, a);
 }
 
+TEST(correctness, shr_signed_exact) {
+  big_integer a = -4;
+  EXPECT_EQ(-2, a >> 1);
+  EXPECT_EQ(-1, a >> 2);
+  EXPECT_EQ(-1, a >> 3);
+  EXPECT_EQ(-1, a >> 100);
+
+  big_integer b = big_integer(-1) << 64;
+  EXPECT_EQ(big_integer(-1) << 32, b >> 32);
+  EXPECT_EQ(-1, b >> 64);
+  EXPECT_EQ(-2, (b - 1) >> 64);
+  EXPECT_EQ(-1, (b + 1) >> 64);
+}
+
 TEST(correctness, shr_return_value) {
   big_integer a = 64;
 
@@ -692,6 +800,26 @@ TEST(correctness, div_randomized) {
 
 // y2019 tests
 
+TEST(correctness_random, string_conv) {
+  std::default_random_engine rng(42);
+  size_t const sizes[] = {31, 32, 33, 1000, 5000, 20000, 100000, 300000};
+  for (size_t size : sizes) {
+    big_integer_gmp a;
+    a.random(size, rng);
+    std::string s = to_string(a);
+    EXPECT_EQ(s, to_string(big_integer(s)));
+    EXPECT_EQ(to_string(-a), to_string(-big_integer(s)));
+  }
+  size_t const lengths[] = {9, 10, 18, 19, 288, 289, 5000};
+  for (size_t length : lengths) {
+    std::string ten = "1" + std::string(length, '0'), nines(length, '9');
+    EXPECT_EQ(ten, to_string(big_integer(ten)));
+    EXPECT_EQ(nines, to_string(big_integer(nines)));
+    EXPECT_EQ(ten, to_string(big_integer(nines) + 1));
+    EXPECT_EQ("-" + ten, to_string(big_integer("-" + std::string(300, '0') + ten)));
+  }
+}
+
 TEST(correctness_random, cmp) {
   std::default_random_engine rng(42);
   for (size_t itn = 0; itn != number_of_iterations; ++itn) {
@@ -744,6 +872,62 @@ TEST(correctness_random, mul) {
   }
 }
 
+TEST(correctness_random, mul_karatsuba) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][2] = {{31, 31}, {32, 32}, {33, 32}, {63, 40}, {64, 64}, {129, 100}, {300, 40}, {513, 511}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b;
+    a.random(size[0] * 32, rng);
+    b.random(size[1] * 32, rng);
+    big_integer_gmp c = a * b;
+    big_integer R = big_integer(to_string(a)) * big_integer(to_string(b));
+    EXPECT_EQ(to_string(c), to_string(R));
+  }
+}
+
+TEST(correctness_random, mul_toom3) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][2] = {{127, 127}, {128, 128}, {129, 128}, {190, 128}, {256, 256}, {385, 383}, {1000, 999}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b;
+    a.random(size[0] * 32, rng);
+    b.random(size[1] * 32, rng);
+    big_integer_gmp c = a * b;
+    big_integer R = big_integer(to_string(a)) * big_integer(to_string(b));
+    EXPECT_EQ(to_string(c), to_string(R));
+  }
+}
+
+TEST(correctness_random, mul_ntt) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][2] = {{4095, 4095}, {4096, 4096}, {4097, 4096}, {9000, 4100}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b;
+    a.random(size[0] * 32, rng);
+    b.random(size[1] * 32, rng);
+    big_integer_gmp c = a;
+    c *= b;
+    big_integer R = big_integer(to_string(a));
+    R *= big_integer(to_string(b));
+    EXPECT_EQ(to_string(c), to_string(R));
+  }
+}
+
+TEST(correctness_random, sqr) {
+  std::default_random_engine rng(42);
+  size_t const sizes[] = {1, 7, 31, 32, 100, 127, 128, 300, 4095, 4096};
+  for (size_t size : sizes) {
+    big_integer_gmp a;
+    a.random(size * 32, rng);
+    big_integer_gmp c = a * a;
+    big_integer R = big_integer(to_string(a));
+    big_integer copy = R;
+    EXPECT_EQ(to_string(c), to_string(R * copy));
+    R *= R;
+    EXPECT_EQ(to_string(c), to_string(R));
+  }
+}
+
 TEST(correctness_random, div) {
   std::default_random_engine rng(322);
   for (size_t itn = 0; itn != number_of_iterations; ++itn) {
@@ -760,6 +944,36 @@ TEST(correctness_random, div) {
   }
 }
 
+TEST(correctness_random, div_divide_and_conquer) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][2] = {{95, 47}, {96, 48}, {97, 49}, {150, 100}, {300, 64}, {1000, 500}, {1500, 700}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b;
+    a.random(size[0] * 32, rng);
+    b.random(size[1] * 32, rng);
+    big_integer A = big_integer(to_string(a)), B = big_integer(to_string(b));
+    EXPECT_EQ(to_string(a / b), to_string(A / B));
+    EXPECT_EQ(to_string(a % b), to_string(A % B));
+  }
+}
+
+TEST(correctness_random, reciprocal) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][2] = {{3, 1}, {40, 20}, {300, 100}, {9000, 4100}, {17000, 4100}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b;
+    a.random(size[0] * 32, rng);
+    b.random(size[1] * 32, rng);
+    b = -b;
+    big_integer A = big_integer(to_string(a)), B = big_integer(to_string(b));
+    big_reciprocal rec(B);
+    EXPECT_EQ(to_string(a / b), to_string(rec.quotient(A)));
+    EXPECT_EQ(to_string(a % b), to_string(rec.remainder(A)));
+    EXPECT_EQ(to_string(-a / b), to_string(rec.quotient(-A)));
+    EXPECT_EQ(to_string(-a % b), to_string(rec.remainder(-A)));
+  }
+}
+
 TEST(correctness_random, mod) {
   std::default_random_engine rng(322);
   for (size_t itn = 0; itn != number_of_iterations; ++itn) {
@@ -776,6 +990,22 @@ TEST(correctness_random, mod) {
   }
 }
 
+TEST(correctness_random, divmod) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a, b;
+    a.random(max_size, rng);
+    b.random(max_size / (itn % 8 + 1), rng);
+    std::pair<big_integer, big_integer> R = divmod(big_integer(to_string(a)), big_integer(to_string(b)));
+    EXPECT_EQ(to_string(a / b), to_string(R.first));
+    EXPECT_EQ(to_string(a % b), to_string(R.second));
+
+    R = divmod(big_integer(to_string(b)), big_integer(to_string(a)));
+    EXPECT_EQ(to_string(b / a), to_string(R.first));
+    EXPECT_EQ(to_string(b % a), to_string(R.second));
+  }
+}
+
 TEST(correctness_random, bitwise) {
   std::default_random_engine rng(42);
   for (size_t itn = 0; itn != number_of_iterations; ++itn) {
@@ -809,6 +1039,540 @@ TEST(correctness_random, bit_shifts) {
   }
 }
 
+TEST(correctness_random, fused) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][3] = {{1, 1, 1}, {40, 20, 90}, {2000, 40, 600}, {3000, 2500, 100}, {200, 300, 6000}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b, c;
+    a.random(size[0] * 32, rng);
+    b.random(size[1] * 32, rng);
+    c.random(size[2] * 32, rng);
+    big_integer A = big_integer(to_string(a)), B = big_integer(to_string(b)), C = big_integer(to_string(c));
+    int shift = static_cast<int>(rng() % 5000);
+
+    big_integer R = C;
+    R += mul(A, B);
+    EXPECT_EQ(to_string(c + a * b), to_string(R));
+    R -= mul(B, A);
+    R -= mul(A, B);
+    EXPECT_EQ(to_string(c - a * b), to_string(R));
+    R = C;
+    R += shl(A, shift);
+    EXPECT_EQ(to_string(c + (a << shift)), to_string(R));
+    R -= shl(B, shift);
+    EXPECT_EQ(to_string(c + (a << shift) - (b << shift)), to_string(R));
+    EXPECT_EQ(to_string(a * b - c * a), to_string(mul(A, B) - mul(C, A)));
+    EXPECT_EQ(to_string(a * b - c), to_string(mul(A, B) - C));
+    EXPECT_EQ(to_string(c - (b << 33)), to_string(C - shl(B, 33)));
+    R = A;
+    R += mul(R, B);
+    EXPECT_EQ(to_string(a + a * b), to_string(R));
+  }
+}
+
+TEST(correctness, fused_inner_product) {
+  std::vector<big_integer> x, y;
+  big_integer expected;
+  for (int i = 0; i < 100; i++) {
+    x.push_back((big_integer(i - 37) << (i * 7)) - 1);
+    y.push_back(big_integer(1000000007) * (50 - i) + i);
+    expected += x.back() * y.back();
+  }
+  big_integer acc;
+  for (size_t i = 0; i < x.size(); i++) {
+    acc += mul(x[i], y[i]);
+  }
+  EXPECT_EQ(expected, acc);
+  for (size_t i = 0; i < x.size(); i++) {
+    acc -= mul(x[i], y[i]);
+  }
+  EXPECT_EQ(to_string(acc), "0");
+  acc += shl(big_integer(-1), 100);
+  acc += shl(big_integer(1), 99);
+  acc -= shl(big_integer(-1), 99);
+  EXPECT_EQ(to_string(acc), "0");
+}
+
+TEST(correctness, powmod) {
+  EXPECT_EQ(powmod(3, 200, 1000000007), 136318165);
+  EXPECT_EQ(powmod(-3, 201, 1000000007), 591045512);
+  EXPECT_EQ(powmod(12345, 0, 1000000007), 1);
+  EXPECT_EQ(powmod(12345, 0, 1), 0);
+  EXPECT_EQ(powmod(7, 10, -1000), 249);
+  EXPECT_EQ(powmod(2, 100, 1024), 0);
+
+  EXPECT_THROW(montgomery_context(big_integer(1000)), std::invalid_argument);
+  EXPECT_THROW(montgomery_context(big_integer(0)), std::invalid_argument);
+  EXPECT_THROW(montgomery_context64(big_integer64(-2) << 100), std::invalid_argument);
+  montgomery_context ctx(big_integer(-1001));
+  EXPECT_EQ(ctx.modulus(), 1001);
+}
+
+TEST(correctness, gcd) {
+  EXPECT_EQ(gcd(big_integer(12), big_integer(18)), 6);
+  EXPECT_EQ(gcd(big_integer(-12), big_integer(18)), 6);
+  EXPECT_EQ(gcd(big_integer(17), big_integer(-5)), 1);
+  EXPECT_EQ(gcd(big_integer(0), big_integer(-5)), 5);
+  EXPECT_EQ(gcd(big_integer(0), big_integer(0)), 0);
+  EXPECT_EQ(lcm(big_integer(4), big_integer(-6)), 12);
+  EXPECT_EQ(lcm(big_integer(0), big_integer(6)), 0);
+
+  big_integer g, x, y;
+  std::tie(g, x, y) = xgcd(big_integer(240), big_integer(46));
+  EXPECT_EQ(g, 2);
+  EXPECT_EQ(x, 14);
+  EXPECT_EQ(y, -73);
+  std::tie(g, x, y) = xgcd(big_integer(-7), big_integer(0));
+  EXPECT_EQ(g, 7);
+  EXPECT_EQ(x, -1);
+  EXPECT_EQ(y, 0);
+
+  EXPECT_EQ(modinv(big_integer(3), big_integer(11)), 4);
+  EXPECT_EQ(modinv(big_integer(-3), big_integer(11)), 7);
+  EXPECT_EQ(modinv(big_integer(3), big_integer(-11)), 4);
+  EXPECT_EQ(modinv(big_integer(6), big_integer(9)), 0);
+  EXPECT_EQ(modinv(big_integer(5), big_integer(1)), 0);
+}
+
+TEST(correctness_random, powmod) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][3] = {{1, 1, 1}, {3, 2, 2}, {40, 20, 9}, {100, 70, 1}, {10, 4, 40}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b, e, m;
+    a.random(size[0] * 32, rng);
+    b.random(size[0] * 32, rng);
+    e.random(size[1] * 32, rng);
+    m.random(size[2] * 32, rng);
+    if (e < 0) {
+      e = -e;
+    }
+    big_integer A = big_integer(to_string(a)), E = big_integer(to_string(e)), M = big_integer(to_string(m));
+    EXPECT_EQ(to_string(powmod(a, e, m * 2 + 1)), to_string(powmod(A, E, M * 2 + 1)));
+    EXPECT_EQ(to_string(powmod(a, e, m * 2)), to_string(powmod(A, E, M * 2)));
+
+    big_integer_gmp odd = m * 2 + 1;
+    if (odd < 0) {
+      odd = -odd;
+    }
+    montgomery_context ctx(M * 2 + 1);
+    big_integer B = big_integer(to_string(b));
+    big_integer x = ctx.to_montgomery(A), y = ctx.to_montgomery(B);
+    big_integer_gmp ra = a % odd, rb = b % odd;
+    EXPECT_EQ(to_string((ra * rb % odd + odd) % odd), to_string(ctx.from_montgomery(ctx.mulmod(x, y))));
+    EXPECT_EQ(to_string((ra * ra % odd + odd) % odd), to_string(ctx.from_montgomery(ctx.sqrmod(x))));
+
+    montgomery_context64 ctx64(big_integer64(to_string(odd)));
+    big_integer64 A64 = big_integer64(to_string(a)), E64 = big_integer64(to_string(e));
+    EXPECT_EQ(to_string(powmod(a, e, odd)), to_string(ctx64.powmod(A64, E64)));
+  }
+}
+
+TEST(correctness_random, gcd) {
+  std::default_random_engine rng(19);
+  size_t const sizes[][3] = {{1, 1, 0}, {2, 1, 1}, {3, 3, 1}, {20, 7, 0}, {60, 60, 5}, {150, 140, 30}, {1500, 1400, 0},
+                             {1200, 1200, 300}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b, c;
+    a.random(size[0] * 32, rng);
+    b.random(size[1] * 32, rng);
+    c.random(size[2] * 32, rng);
+    if (c == 0) {
+      c = 1;
+    }
+    a *= c;
+    b *= c;
+    big_integer A = big_integer(to_string(a)), B = big_integer(to_string(b));
+    big_integer G = gcd(A, B);
+    EXPECT_EQ(to_string(gcd(a, b)), to_string(G));
+    EXPECT_EQ(to_string(lcm(a, b)), to_string(lcm(A, B)));
+
+    big_integer g, x, y;
+    std::tie(g, x, y) = xgcd(A, B);
+    EXPECT_EQ(G, g);
+    EXPECT_EQ(g, A * x + B * y);
+    EXPECT_TRUE(x >= 0 && x * g < (B < 0 ? -B : B));
+    EXPECT_EQ(to_string(modinv(a, b)), to_string(modinv(A, B)));
+
+    big_integer64 g64, x64, y64, A64 = big_integer64(to_string(a)), B64 = big_integer64(to_string(b));
+    std::tie(g64, x64, y64) = xgcd(A64, B64);
+    EXPECT_EQ(to_string(G), to_string(g64));
+    EXPECT_EQ(g64, A64 * x64 + B64 * y64);
+  }
+}
+
+TEST(correctness, gcd_fibonacci) {
+  // every quotient of consecutive Fibonacci numbers is one, the longest remainder sequence there is
+  big_integer a = 1, b = 0;
+  for (int i = 0; i < 30000; i++) {
+    b += a;
+    std::swap(a, b);
+  }
+  big_integer g, x, y;
+  std::tie(g, x, y) = xgcd(a, b);
+  EXPECT_EQ(gcd(a, b), 1);
+  EXPECT_EQ(g, 1);
+  EXPECT_EQ(a * x + b * y, 1);
+  EXPECT_EQ(modinv(b, a) * b % a, 1);
+}
+
+TEST(correctness, roots) {
+  EXPECT_EQ(isqrt(big_integer(0)), 0);
+  EXPECT_EQ(isqrt(big_integer(1)), 1);
+  EXPECT_EQ(isqrt(big_integer(15)), 3);
+  EXPECT_EQ(isqrt(big_integer(16)), 4);
+  EXPECT_EQ(isqrt(big_integer("100000000000000000000000000000000000000000")), big_integer("316227766016837933199"));
+  EXPECT_EQ(iroot(big_integer(-27), 3), -3);
+  EXPECT_EQ(iroot(big_integer(-26), 3), -2);
+  EXPECT_EQ(iroot(big_integer(7), 5), 1);
+  EXPECT_EQ(iroot(big_integer(-7), 1), -7);
+
+  big_integer x("123456789012345678901234567890123456789");
+  EXPECT_EQ(isqrt(x * x + 2 * x), x);
+  EXPECT_EQ(isqrt(x * x - 1), x - 1);
+  EXPECT_EQ(iroot(x * x * x * x * x * x * x, 7), x);
+  EXPECT_EQ(iroot(x * x * x * x * x * x * x - 1, 7), x - 1);
+
+  EXPECT_TRUE(is_perfect_power(big_integer(0)));
+  EXPECT_TRUE(is_perfect_power(big_integer(1)));
+  EXPECT_TRUE(is_perfect_power(big_integer(-1)));
+  EXPECT_FALSE(is_perfect_power(big_integer(2)));
+  EXPECT_TRUE(is_perfect_power(big_integer(8)));
+  EXPECT_TRUE(is_perfect_power(big_integer(-8)));
+  EXPECT_FALSE(is_perfect_power(big_integer(-4)));
+  EXPECT_TRUE(is_perfect_power(big_integer(1) << 97));
+  EXPECT_FALSE(is_perfect_power(x * x * x * 10));
+  EXPECT_TRUE(is_perfect_power(-x * x * x * x * x));
+}
+
+TEST(correctness_random, roots) {
+  std::default_random_engine rng(20);
+  size_t const sizes[] = {1, 2, 3, 10, 45, 200, 1000};
+  for (size_t n : sizes) {
+    big_integer_gmp a;
+    a.random(n * 32 - 5, rng);
+    if (a < 0) {
+      a = -a;
+    }
+    big_integer A = big_integer(to_string(a));
+    EXPECT_EQ(to_string(isqrt(a)), to_string(isqrt(A)));
+    EXPECT_EQ(to_string(isqrt(a)), to_string(isqrt(big_integer64(to_string(a)))));
+    for (size_t k : {3, 5, 8, 31, 100}) {
+      EXPECT_EQ(to_string(iroot(a, k)), to_string(iroot(A, k)));
+      EXPECT_EQ(to_string(iroot(-a, k | 1)), to_string(iroot(-A, k | 1)));
+      EXPECT_EQ(to_string(iroot(a, k)), to_string(iroot(big_integer64(to_string(a)), k)));
+    }
+
+    big_integer_gmp r;
+    r.random(n * 8, rng);
+    big_integer R = big_integer(to_string(r));
+    big_integer powers[] = {R * R, R * R * R, R * R * R * R * R * R, A, A * A + 1, A * A * A - 1};
+    for (big_integer const &p : powers) {
+      EXPECT_EQ(is_perfect_power(big_integer_gmp(to_string(p))), is_perfect_power(p));
+    }
+  }
+}
+
+TEST(correctness, pow) {
+  EXPECT_EQ(pow(big_integer(0), 0), 1);
+  EXPECT_EQ(pow(big_integer(0), 5), 0);
+  EXPECT_EQ(pow(big_integer(7), 1), 7);
+  EXPECT_EQ(pow(big_integer(-3), 5), -243);
+  EXPECT_EQ(pow(big_integer(-1), 1000000001), -1);
+  EXPECT_EQ(pow(big_integer(-2), 100), big_integer(1) << 100);
+  EXPECT_EQ(pow(big_integer(10), 30), big_integer("1000000000000000000000000000000"));
+  EXPECT_EQ(pow(big_integer(12), 25), big_integer("953962166440690129601298432"));
+  EXPECT_EQ(pow(big_integer("-123456789012345678901"), 3),
+            big_integer("-1881676372353657772535990485684393532449643155190439821666701"));
+  EXPECT_EQ(pow(big_integer(6), 40) >> 40, pow(big_integer(3), 40));
+  EXPECT_EQ(pow(big_integer(-1), SIZE_MAX), -1);
+  EXPECT_THROW(pow(big_integer(4), SIZE_MAX / 2 + 1), std::length_error);
+  EXPECT_THROW(pow(big_integer64(-8), SIZE_MAX / 3 + 1), std::length_error);
+}
+
+TEST(correctness_random, pow) {
+  std::default_random_engine rng(22);
+  size_t const bits[] = {2, 5, 31, 32, 64, 100, 700};
+  for (size_t b : bits) {
+    for (size_t e : {2, 3, 17, 64, 255, 1000, 2049}) {
+      big_integer_gmp a;
+      a.random(b, rng);
+      if (rng() % 2 == 0) {
+        a <<= static_cast<int>(rng() % 70);
+      }
+      EXPECT_EQ(to_string(pow(a, e)), to_string(pow(big_integer(to_string(a)), e)));
+      EXPECT_EQ(to_string(pow(a, e)), to_string(pow(big_integer64(to_string(a)), e)));
+    }
+  }
+}
+
+TEST(correctness, factorial) {
+  EXPECT_EQ(big_integer::factorial(0), 1);
+  EXPECT_EQ(big_integer::factorial(1), 1);
+  EXPECT_EQ(big_integer::factorial(5), 120);
+  EXPECT_EQ(big_integer::factorial(25), big_integer("15511210043330985984000000"));
+  EXPECT_EQ(big_integer::binomial(10, 3), 120);
+  EXPECT_EQ(big_integer::binomial(10, 7), 120);
+  EXPECT_EQ(big_integer::binomial(10, 0), 1);
+  EXPECT_EQ(big_integer::binomial(10, 10), 1);
+  EXPECT_EQ(big_integer::binomial(5, 7), 0);
+  EXPECT_EQ(big_integer::binomial(0, 0), 1);
+  EXPECT_EQ(big_integer::binomial(100, 50), big_integer("100891344545564193334812497256"));
+  EXPECT_EQ(product(std::vector<big_integer>()), 1);
+  EXPECT_EQ(product(std::vector<big_integer>{-3, 7, -2}), 42);
+}
+
+TEST(correctness_random, product) {
+  std::default_random_engine rng(21);
+  size_t const counts[][2] = {{1, 1}, {7, 3}, {100, 1}, {1000, 2}, {300, 40}, {20, 800}};
+  for (auto const &count : counts) {
+    big_integer_gmp expected = 1;
+    std::vector<big_integer> factors;
+    for (size_t i = 0; i < count[0]; i++) {
+      big_integer_gmp x;
+      x.random((1 + rng() % count[1]) * 32, rng);
+      expected *= x;
+      factors.emplace_back(to_string(x));
+    }
+    factors[rng() % factors.size()] <<= 3000;
+    expected <<= 3000;
+    EXPECT_EQ(to_string(expected), to_string(product(factors)));
+    EXPECT_EQ(to_string(expected), to_string(product(factors)));
+  }
+
+  for (size_t n : {2, 3, 100, 1000, 4321, 30000}) {
+    EXPECT_EQ(to_string(big_integer_gmp::factorial(n)), to_string(big_integer::factorial(n)));
+    EXPECT_EQ(to_string(big_integer_gmp::factorial(n)), to_string(big_integer64::factorial(n)));
+    for (size_t k : {n / 2, n / 3, n / 50, n / 100, size_t(7)}) {
+      EXPECT_EQ(to_string(big_integer_gmp::binomial(n, k)), to_string(big_integer::binomial(n, k)));
+    }
+  }
+  EXPECT_EQ(to_string(big_integer_gmp::binomial(100000000000ull, 20)),
+            to_string(big_integer::binomial(100000000000ull, 20)));
+}
+
+TEST(correctness_random, big_divisor) {
+  std::default_random_engine rng(7);
+  size_t const sizes[] = {1, 2, 5, 16, 24, 40, 70};
+  for (size_t k : sizes) {
+    big_integer_gmp d;
+    d.random(k * 32, rng);
+    if (d == 0) {
+      d = 1;
+    }
+    big_integer D = big_integer(to_string(d));
+    big_divisor divisor(D);
+    big_divisor64 divisor64(big_integer64(to_string(d)));
+    for (size_t n : {k / 2, k, k + 1, 2 * k - 1, 2 * k, 2 * k + 1, 5 * k}) {
+      big_integer_gmp a;
+      a.random(n * 32 + 7, rng);
+      big_integer A = big_integer(to_string(a));
+      std::pair<big_integer, big_integer> qr = divisor.divmod(A);
+      EXPECT_EQ(to_string(a / d), to_string(qr.first));
+      EXPECT_EQ(to_string(a % d), to_string(qr.second));
+      EXPECT_EQ(qr.first, divisor.div(A));
+      EXPECT_EQ(qr.second, divisor.mod(A));
+      EXPECT_EQ(to_string(a % d), to_string(divisor64.mod(big_integer64(to_string(a)))));
+    }
+  }
+}
+
+namespace {
+// k-limb divisors at the ends of the normalized range, with dividends up to BASE^(2k) - 1, push the Barrett estimate
+// to its largest shortfall; the plain division operators are the reference
+template <typename Integer, typename Divisor>
+void check_barrett_edges(size_t k, size_t limb_bits) {
+  int const bits = static_cast<int>(k * limb_bits);
+  Integer top = Integer(1) << (bits - 1);
+  for (Integer const& d : {top, top + 1, top + top / 3, 2 * top - 1, (2 * top - 1) >> 1}) {
+    Divisor divisor(d);
+    for (Integer const& a : {d, d * d - 1, d * (d + 1) - 1, (Integer(1) << 2 * bits) - 1, d * (d - 1) / 3}) {
+      std::pair<Integer, Integer> qr = divisor.divmod(a);
+      EXPECT_EQ(a / d, qr.first);
+      EXPECT_EQ(a % d, qr.second);
+      EXPECT_EQ(-a / d, divisor.div(-a));
+      EXPECT_EQ(-a % d, divisor.mod(-a));
+    }
+  }
+}
+}
+
+TEST(correctness, big_divisor_barrett) {
+  for (size_t k : {size_t(BIG_INTEGER_BARRETT_THRESHOLD), size_t(BIG_INTEGER_KARATSUBA_THRESHOLD) + 1,
+                   size_t(BIG_INTEGER_BARRETT_MAX_SIZE)}) {
+    check_barrett_edges<big_integer, big_divisor>(k, 32);
+    check_barrett_edges<big_integer64, big_divisor64>(k, 64);
+  }
+}
+
+TEST(correctness, wide_integer) {
+  wide_uint<128> top = wide_uint<128>(1) << 127;
+  EXPECT_EQ(top + top, 0);
+  EXPECT_EQ(top - 1, ~top);
+  EXPECT_EQ(top >> 127, 1);
+  EXPECT_EQ(top << 1, 0);
+  EXPECT_EQ(wide_uint<128>(-1), ~wide_uint<128>(0));
+  EXPECT_TRUE(wide_uint<128>(-1) > top);
+  EXPECT_EQ(to_string(wide_uint<128>(-1)), "340282366920938463463374607431768211455");
+  EXPECT_EQ(big_integer(wide_uint<128>(-1)), (big_integer(1) << 128) - 1);
+
+  wide_int<128> min = wide_int<128>(1) << 127;
+  EXPECT_TRUE(min < 0);
+  EXPECT_EQ(-min, min);
+  EXPECT_EQ(min - 1, ~min);
+  EXPECT_EQ(big_integer64(min), -(big_integer64(1) << 127));
+  EXPECT_EQ(min >> 200, -1);
+  EXPECT_EQ(wide_int<128>(-7) / 2, -3);
+  EXPECT_EQ(wide_int<128>(-7) % 2, -1);
+  EXPECT_EQ(wide_int<128>(7) % -2, 1);
+  EXPECT_EQ(wide_int<128>(-1) >> 5, -1);
+  EXPECT_EQ(big_integer(wide_int<192>(-5)), -5);
+
+  big_integer x("-1234567890123456789012345678901234567890123456789012345");
+  EXPECT_EQ(big_integer(wide_int<256>(x)), x);
+  EXPECT_EQ(big_integer(wide_int<192>(x)), x);
+  EXPECT_EQ(big_integer(wide_uint<256>(x)), (big_integer(1) << 256) + x);
+  EXPECT_EQ(big_integer(wide_uint<128>(x)), x & ((big_integer(1) << 128) - 1));
+}
+
+TEST(correctness, literal) {
+  static_assert(sizeof(123_bi) == 8, "three decimal digits fit a limb");
+  static_assert(sizeof(18446744073709551615_bi) == 16, "twenty digits need a second limb for the sign");
+  constexpr auto constant = 0xfedcba9876543210fedcba9876543210_bi;
+  EXPECT_EQ(to_string(constant), "338770000845734292534325025077361652240");
+  EXPECT_EQ(to_string(wide_int<128>(constant)), "-1512366075204170929049582354406559216");
+  EXPECT_EQ(wide_uint<128>(constant), ~wide_uint<128>(0x0123456789abcdef0123456789abcdef_bi));
+  EXPECT_EQ(big_integer(0_bi), 0);
+  EXPECT_EQ(big_integer(-5_bi), -5);
+  EXPECT_EQ(big_integer(1'000'000_bi), 1000000);
+  EXPECT_EQ(big_integer(0b1111011_bi), 123);
+  EXPECT_EQ(big_integer(0173_bi), 123);
+  EXPECT_EQ(big_integer(0X7B_bi), 123);
+
+  big_integer x = 123456789012345678901234567890123456789012345678901234567890_bi;
+  EXPECT_EQ(x, big_integer("123456789012345678901234567890123456789012345678901234567890"));
+  EXPECT_EQ(x * 2 + 1, 246913578024691357802469135780246913578024691357802469135781_bi);
+  big_integer64 y = 0xffffffffffffffffffffffffffffffff_bi;
+  EXPECT_EQ(y, (big_integer64(1) << 128) - 1);
+  EXPECT_EQ(-99999999999999999999999999999999999999_bi, wide_int<192>(big_integer("-99999999999999999999999999999999999999")));
+
+  // the width follows the value, not the digit count, so the largest value of a width is assigned without a cast
+  wide_int<128> max = 170141183460469231731687303715884105727_bi;
+  EXPECT_EQ(max, ~(wide_int<128>(1) << 127));
+  wide_int<128> hex_max = 0x7fffffffffffffffffffffffffffffff_bi;
+  EXPECT_EQ(hex_max, max);
+  wide_int<64> max64 = 9223372036854775807_bi;
+  EXPECT_EQ(max64, wide_int<64>(INT64_MAX));
+  static_assert(sizeof(170141183460469231731687303715884105728_bi) == 24, "2^127 needs a third limb for the sign");
+  static_assert(sizeof(000000000000000000000000000000000000000000001_bi) == 8, "leading zeros take no limbs");
+}
+
+namespace {
+template <size_t Bits, bool Signed>
+void check_wide_random(std::default_random_engine& rng) {
+  using wide = basic_wide_integer<Bits, Signed>;
+  auto random_wide = [&rng]() {
+    wide res;
+    for (size_t i = 1 + rng() % (Bits / 64); i > 0; i--) {
+      uint64_t limb = static_cast<uint64_t>(rng()) << 62 ^ static_cast<uint64_t>(rng()) << 31 ^ rng();
+      size_t pattern = rng() % 4;
+      res = res << 64 | wide(pattern == 0 ? 0 : pattern == 1 ? ~static_cast<uint64_t>(0) : limb);
+    }
+    return res;
+  };
+  for (size_t i = 0; i < 200; i++) {
+    wide a = random_wide(), b = random_wide();
+    if (Signed && rng() % 2 == 0) {
+      b = -b;
+    }
+    big_integer64 A(a), B(b);
+    EXPECT_EQ(wide(A), a);
+    EXPECT_EQ(to_string(A), to_string(a));
+    EXPECT_EQ(to_string(big_integer(a)), to_string(a));
+    EXPECT_EQ(wide(A + B), a + b);
+    EXPECT_EQ(wide(A - B), a - b);
+    EXPECT_EQ(wide(A * B), a * b);
+    EXPECT_EQ(wide(A & B), a & b);
+    EXPECT_EQ(wide(A | B), a | b);
+    EXPECT_EQ(wide(A ^ B), a ^ b);
+    EXPECT_EQ(wide(~A), ~a);
+    EXPECT_EQ(wide(-A), -a);
+    EXPECT_EQ(wide(A + 1), ++wide(a));
+    EXPECT_EQ(wide(A - 1), --wide(a));
+    if (b != 0) {
+      EXPECT_EQ(wide(A / B), a / b);
+      EXPECT_EQ(wide(A % B), a % b);
+    }
+    EXPECT_EQ(A < B, a < b);
+    EXPECT_EQ(A == B, a == b);
+    EXPECT_EQ(A == A, a == a);
+    int shift = static_cast<int>(rng() % (Bits + 10));
+    EXPECT_EQ(wide(A << shift), a << shift);
+    EXPECT_EQ(wide(A >> shift), a >> shift);
+  }
+}
+}
+
+TEST(correctness_random, wide_integer) {
+  std::default_random_engine rng(23);
+  check_wide_random<64, false>(rng);
+  check_wide_random<64, true>(rng);
+  check_wide_random<128, false>(rng);
+  check_wide_random<128, true>(rng);
+  check_wide_random<256, false>(rng);
+  check_wide_random<256, true>(rng);
+  check_wide_random<576, false>(rng);
+  check_wide_random<1024, true>(rng);
+}
+
+TEST(correctness_random, limb64) {
+  std::default_random_engine rng(42);
+  size_t const sizes[][2] = {{1, 1}, {3, 2}, {40, 20}, {100, 70}, {300, 200}, {2100, 2050}, {4100, 4097}, {5000, 100}};
+  for (auto const &size : sizes) {
+    big_integer_gmp a, b;
+    a.random(size[0] * 64, rng);
+    b.random(size[1] * 64, rng);
+    big_integer64 A = big_integer64(to_string(a)), B = big_integer64(to_string(b));
+    EXPECT_EQ(to_string(a + b), to_string(A + B));
+    EXPECT_EQ(to_string(a - b), to_string(A - B));
+    EXPECT_EQ(to_string(a * b), to_string(A * B));
+    EXPECT_EQ(to_string(a * a), to_string(A * A));
+    EXPECT_EQ(to_string(a / b), to_string(A / B));
+    EXPECT_EQ(to_string(a % b), to_string(A % B));
+    EXPECT_EQ(to_string(a & b), to_string(A & B));
+    EXPECT_EQ(to_string(a | b), to_string(A | B));
+    EXPECT_EQ(to_string(a ^ b), to_string(A ^ B));
+    EXPECT_EQ(to_string(a << 100), to_string(A << 100));
+    EXPECT_EQ(to_string(a >> 100), to_string(A >> 100));
+    EXPECT_EQ(to_string(a * b / b), to_string(big_reciprocal64(B).quotient(A * B)));
+  }
+}
+
+// carries that run through whole operands, at every length around the four-limb blocks of the x86-64 kernels
+TEST(correctness_random, limb64_carries) {
+  std::default_random_engine rng(25);
+  for (size_t n = 1; n <= 13; n++) {
+    for (size_t m = 1; m <= n; m++) {
+      big_integer_gmp ones_a = (big_integer_gmp(1) << static_cast<int>(64 * n)) - 1;
+      big_integer_gmp ones_b = (big_integer_gmp(1) << static_cast<int>(64 * m)) - 1;
+      big_integer_gmp a, b;
+      a.random(n * 64, rng);
+      b.random(m * 64, rng);
+      for (auto const &x : {ones_a, a}) {
+        for (auto const &y : {ones_b, b, big_integer_gmp(1)}) {
+          big_integer64 X = big_integer64(to_string(x)), Y = big_integer64(to_string(y));
+          EXPECT_EQ(to_string(x + y), to_string(X + Y));
+          EXPECT_EQ(to_string(x - y), to_string(X - Y));
+          EXPECT_EQ(to_string(y - x), to_string(Y - X));
+          EXPECT_EQ(to_string(x * y), to_string(X * Y));
+          EXPECT_EQ(to_string(x * x), to_string(X * X));
+          EXPECT_EQ(to_string(x * y / y), to_string(X * Y / Y));
+          EXPECT_EQ(to_string((x * y + x) % y), to_string((X * Y + X) % Y));
+        }
+      }
+    }
+  }
+}
+
 // TODO: extend due to idea
 TEST(correctness_twos_complement, simple) {
   std::string a = "-36893488147419103232"; // -(1 << 65)
@@ -0,0 +1,62 @@
+#ifndef LIMB_VECTOR_H
+#define LIMB_VECTOR_H
+
+#include <cstddef>
+#include <vector>
+
+// the plain storage policy of big_integer: a std::vector whose empty state reads as a single zero limb, so a
+// moved-from vector is already a valid zero and neither a move nor a default construction touches the heap; the
+// first write through a non-const accessor allocates that limb for real
+template <typename T>
+class limb_vector {
+ public:
+  size_t size() const {
+    return data_.empty() ? 1 : data_.size();
+  }
+
+  T const &operator[](size_t i) const {
+    return data_.empty() ? zero_ : data_[i];
+  }
+
+  T &operator[](size_t i) {
+    materialize();
+    return data_[i];
+  }
+
+  T const &back() const {
+    return data_.empty() ? zero_ : data_.back();
+  }
+
+  void push_back(T const &val) {
+    materialize();
+    data_.push_back(val);
+  }
+
+  void resize(size_t n, T const &val = T()) {
+    if (n > size()) {
+      materialize();
+      data_.resize(n, val);
+    } else if (n < data_.size()) {
+      data_.resize(n);
+    }
+  }
+
+  void swap(limb_vector &other) noexcept {
+    data_.swap(other.data_);
+  }
+
+ private:
+  static T const zero_;
+  std::vector<T> data_;
+
+  void materialize() {
+    if (data_.empty()) {
+      data_.push_back(T());
+    }
+  }
+};
+
+template <typename T>
+T const limb_vector<T>::zero_ = T();
+
+#endif // LIMB_VECTOR_H
@@ -0,0 +1,449 @@
+#ifndef WIDE_INTEGER_H
+#define WIDE_INTEGER_H
+
+#include "big_integer.h"
+
+#include <type_traits>
+
+// the radix of the characters of a numeric literal: 0x, 0b and a leading 0 select hexadecimal, binary and octal
+constexpr uint32_t wide_literal_base(char const* s, size_t n) {
+  if (n < 2 || s[0] != '0') {
+    return 10;
+  }
+  return s[1] == 'x' || s[1] == 'X' ? 16 : s[1] == 'b' || s[1] == 'B' ? 2 : 8;
+}
+
+// limbs enough for the digits of a numeric literal and a sign bit, counted as whole bits: a bound for the width of
+// its value, which may need a limb less
+constexpr size_t wide_literal_bits(char const* s, size_t n) {
+  uint32_t base = wide_literal_base(s, n);
+  size_t digits = 0;
+  for (size_t i = base == 16 || base == 2 ? 2 : 0; i < n; i++) {
+    digits += s[i] != '\'';
+  }
+  size_t bits = base == 10 ? digits * 10 / 3 + 1 : digits * (base == 16 ? 4 : base == 8 ? 3 : 1);
+  return (bits + 64) / 64 * 64;
+}
+
+// Bits-wide integers in a fixed array of 64-bit limbs, two's complement when Signed. As with the built-in types,
+// + - * and the bitwise operations wrap around modulo 2^Bits, while comparisons, / and % (rounded toward zero) and
+// >> (arithmetic for Signed) depend on the signedness; shifts by Bits or more give 0, or -1 for >> of a negative
+// value. Every loop runs over the compile-time limb count and is unrolled for widths up to 1024 bits, and division
+// goes through the basecase kernels of big_integer64 on stack buffers: nothing is ever allocated.
+// Conversion to a big_integer is exact, the explicit one from a big_integer reduces modulo 2^Bits.
+template <size_t Bits, bool Signed>
+struct basic_wide_integer
+{
+  static_assert(Bits != 0 && Bits % 64 == 0, "wide integers are made of whole 64-bit limbs");
+
+  constexpr basic_wide_integer() : limbs_() {}
+  template <typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+  basic_wide_integer(T a) {
+    limbs_[0] = static_cast<Limb>(a);
+    Limb fill = a < 0 ? MAX_VALUE : 0;
+    for (size_t i = 1; i < N; i++) {
+      limbs_[i] = fill;
+    }
+  }
+  // widening keeps the value and is implicit, narrowing or a change of signedness wraps around and must be explicit
+  template <size_t OtherBits, bool OtherSigned,
+            typename std::enable_if<(OtherBits < Bits && OtherSigned == Signed), int>::type = 0>
+  constexpr basic_wide_integer(basic_wide_integer<OtherBits, OtherSigned> const& a) : limbs_() {
+    extend(a);
+  }
+  template <size_t OtherBits, bool OtherSigned,
+            typename std::enable_if<(OtherBits >= Bits || OtherSigned != Signed), int>::type = 0>
+  constexpr explicit basic_wide_integer(basic_wide_integer<OtherBits, OtherSigned> const& a) : limbs_() {
+    extend(a);
+  }
+  // the value of the characters of a numeric literal modulo 2^Bits, with the radix of wide_literal_base and '
+  // separators skipped
+  static constexpr basic_wide_integer from_literal(char const* s, size_t n) {
+    basic_wide_integer res;
+    uint32_t base = wide_literal_base(s, n);
+    for (size_t i = base == 16 || base == 2 ? 2 : 0; i < n; i++) {
+      char c = s[i];
+      if (c != '\'') {
+        res.mul_add(base, static_cast<Limb>(c >= 'a' ? c - 'a' + 10 : c >= 'A' ? c - 'A' + 10 : c - '0'));
+      }
+    }
+    return res;
+  }
+  // the limbs of the value of a numeric literal and a sign bit, counted as whole bits, for a Bits wide enough to hold
+  // that value and the sign bit
+  static constexpr size_t literal_bits(char const* s, size_t n) {
+    basic_wide_integer value = from_literal(s, n);
+    size_t i = N;
+    while (i > 1 && value.limbs_[i - 1] == 0) {
+      i--;
+    }
+    return (value.limbs_[i - 1] >> 63 == 0 ? i : i + 1) * 64;
+  }
+  template <typename BigLimb, typename Storage>
+  explicit basic_wide_integer(basic_big_integer<BigLimb, Storage> const& a) : limbs_() {
+    using big = basic_big_integer<BigLimb, Storage>;
+    size_t const per_limb = 64 / big::BASE, n = std::min(a.data_.size(), N * per_limb);
+    for (size_t i = 0; i < n; i++) {
+      limbs_[i / per_limb] |= static_cast<Limb>(a.data_[i]) << (i % per_limb * big::BASE);
+    }
+    if (a.sign_) {
+      negate();
+    }
+  }
+  template <typename BigLimb, typename Storage>
+  operator basic_big_integer<BigLimb, Storage>() const {
+    using big = basic_big_integer<BigLimb, Storage>;
+    constexpr size_t per_limb = 64 / big::BASE;
+    bool negative = is_negative();
+    basic_wide_integer magnitude = *this;
+    if (negative) {
+      magnitude.negate();
+    }
+    BigLimb limbs[N * per_limb];
+    for (size_t i = 0; i < N * per_limb; i++) {
+      limbs[i] = static_cast<BigLimb>(magnitude.limbs_[i / per_limb] >> (i % per_limb * big::BASE));
+    }
+    big res;
+    res.add_signed(limbs, N * per_limb, negative);
+    return res;
+  }
+
+  basic_wide_integer& operator+=(basic_wide_integer const& rhs) {
+    double_limb carry = 0;
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      carry += static_cast<double_limb>(limbs_[i]) + rhs.limbs_[i];
+      limbs_[i] = static_cast<Limb>(carry);
+      carry >>= 64;
+    }
+    return *this;
+  }
+  basic_wide_integer& operator-=(basic_wide_integer const& rhs) {
+    Limb borrow = 0;
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      double_limb diff = static_cast<double_limb>(limbs_[i]) - rhs.limbs_[i] - borrow;
+      limbs_[i] = static_cast<Limb>(diff);
+      borrow = static_cast<Limb>(diff >> 64) & 1;
+    }
+    return *this;
+  }
+  // schoolbook, only the columns below 2^Bits
+  basic_wide_integer& operator*=(basic_wide_integer const& rhs) {
+    Limb res[N] = {};
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      double_limb carry = 0;
+      #pragma GCC unroll 16
+      for (size_t j = 0; i + j < N; j++) {
+        carry += static_cast<double_limb>(limbs_[i]) * rhs.limbs_[j] + res[i + j];
+        res[i + j] = static_cast<Limb>(carry);
+        carry >>= 64;
+      }
+    }
+    std::copy(res, res + N, limbs_);
+    return *this;
+  }
+  basic_wide_integer& operator/=(basic_wide_integer const& rhs) {
+    return divide(rhs, true);
+  }
+  basic_wide_integer& operator%=(basic_wide_integer const& rhs) {
+    return divide(rhs, false);
+  }
+
+  basic_wide_integer& operator&=(basic_wide_integer const& rhs) {
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      limbs_[i] &= rhs.limbs_[i];
+    }
+    return *this;
+  }
+  basic_wide_integer& operator|=(basic_wide_integer const& rhs) {
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      limbs_[i] |= rhs.limbs_[i];
+    }
+    return *this;
+  }
+  basic_wide_integer& operator^=(basic_wide_integer const& rhs) {
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      limbs_[i] ^= rhs.limbs_[i];
+    }
+    return *this;
+  }
+
+  // rhs >= 0
+  basic_wide_integer& operator<<=(int rhs) {
+    size_t limbs = static_cast<size_t>(rhs) / 64;
+    uint32_t bits = static_cast<uint32_t>(rhs) % 64;
+    for (size_t i = N; i > 0; i--) {
+      Limb value = 0;
+      if (i > limbs) {
+        value = limbs_[i - 1 - limbs] << bits;
+        if (bits != 0 && i > limbs + 1) {
+          value |= limbs_[i - 2 - limbs] >> (64 - bits);
+        }
+      }
+      limbs_[i - 1] = value;
+    }
+    return *this;
+  }
+  basic_wide_integer& operator>>=(int rhs) {
+    size_t limbs = static_cast<size_t>(rhs) / 64;
+    uint32_t bits = static_cast<uint32_t>(rhs) % 64;
+    Limb fill = is_negative() ? MAX_VALUE : 0;
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      Limb low = i + limbs < N ? limbs_[i + limbs] : fill;
+      Limb high = i + limbs + 1 < N ? limbs_[i + limbs + 1] : fill;
+      limbs_[i] = bits == 0 ? low : (low >> bits) | (high << (64 - bits));
+    }
+    return *this;
+  }
+
+  basic_wide_integer operator+() const {
+    return *this;
+  }
+  constexpr basic_wide_integer operator-() const {
+    basic_wide_integer res = *this;
+    res.negate();
+    return res;
+  }
+  basic_wide_integer operator~() const {
+    basic_wide_integer res;
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      res.limbs_[i] = ~limbs_[i];
+    }
+    return res;
+  }
+
+  basic_wide_integer& operator++() {
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      if (++limbs_[i] != 0) {
+        break;
+      }
+    }
+    return *this;
+  }
+  basic_wide_integer operator++(int) {
+    basic_wide_integer res = *this;
+    ++*this;
+    return res;
+  }
+  basic_wide_integer& operator--() {
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      if (limbs_[i]-- != 0) {
+        break;
+      }
+    }
+    return *this;
+  }
+  basic_wide_integer operator--(int) {
+    basic_wide_integer res = *this;
+    --*this;
+    return res;
+  }
+
+  friend basic_wide_integer operator+(basic_wide_integer a, basic_wide_integer const& b) {
+    a += b;
+    return a;
+  }
+  friend basic_wide_integer operator-(basic_wide_integer a, basic_wide_integer const& b) {
+    a -= b;
+    return a;
+  }
+  friend basic_wide_integer operator*(basic_wide_integer a, basic_wide_integer const& b) {
+    a *= b;
+    return a;
+  }
+  friend basic_wide_integer operator/(basic_wide_integer a, basic_wide_integer const& b) {
+    a /= b;
+    return a;
+  }
+  friend basic_wide_integer operator%(basic_wide_integer a, basic_wide_integer const& b) {
+    a %= b;
+    return a;
+  }
+  friend basic_wide_integer operator&(basic_wide_integer a, basic_wide_integer const& b) {
+    a &= b;
+    return a;
+  }
+  friend basic_wide_integer operator|(basic_wide_integer a, basic_wide_integer const& b) {
+    a |= b;
+    return a;
+  }
+  friend basic_wide_integer operator^(basic_wide_integer a, basic_wide_integer const& b) {
+    a ^= b;
+    return a;
+  }
+  friend basic_wide_integer operator<<(basic_wide_integer a, int b) {
+    a <<= b;
+    return a;
+  }
+  friend basic_wide_integer operator>>(basic_wide_integer a, int b) {
+    a >>= b;
+    return a;
+  }
+
+  friend bool operator==(basic_wide_integer const& a, basic_wide_integer const& b) {
+    return compare(a, b) == 0;
+  }
+  friend bool operator!=(basic_wide_integer const& a, basic_wide_integer const& b) {
+    return compare(a, b) != 0;
+  }
+  friend bool operator<(basic_wide_integer const& a, basic_wide_integer const& b) {
+    return compare(a, b) < 0;
+  }
+  friend bool operator>(basic_wide_integer const& a, basic_wide_integer const& b) {
+    return compare(a, b) > 0;
+  }
+  friend bool operator<=(basic_wide_integer const& a, basic_wide_integer const& b) {
+    return compare(a, b) <= 0;
+  }
+  friend bool operator>=(basic_wide_integer const& a, basic_wide_integer const& b) {
+    return compare(a, b) >= 0;
+  }
+
+  friend std::string to_string(basic_wide_integer const& a) {
+    return to_string(big_integer64(a));
+  }
+  friend std::ostream& operator<<(std::ostream& s, basic_wide_integer const& a) {
+    return s << big_integer64(a);
+  }
+
+ private:
+  using Limb = uint64_t;
+  using double_limb = big_integer_limb_traits<Limb>::double_limb;
+  using kernels = big_integer64;
+  constexpr static size_t N = Bits / 64;
+  constexpr static Limb MAX_VALUE = ~static_cast<Limb>(0);
+  Limb limbs_[N];
+
+  template <size_t OtherBits, bool OtherSigned>
+  friend struct basic_wide_integer;
+
+  template <size_t OtherBits, bool OtherSigned>
+  constexpr void extend(basic_wide_integer<OtherBits, OtherSigned> const& a) {
+    Limb fill = a.is_negative() ? MAX_VALUE : 0;
+    for (size_t i = 0; i < N; i++) {
+      limbs_[i] = i < a.N ? a.limbs_[i] : fill;
+    }
+  }
+
+  constexpr bool is_negative() const {
+    return Signed && (limbs_[N - 1] >> 63) != 0;
+  }
+
+  constexpr void negate() {
+    Limb carry = 1;
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      limbs_[i] = ~limbs_[i] + carry;
+      carry &= limbs_[i] == 0;
+    }
+  }
+
+  // *this * k + add
+  constexpr void mul_add(Limb k, Limb add) {
+    double_limb carry = add;
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < N; i++) {
+      carry += static_cast<double_limb>(limbs_[i]) * k;
+      limbs_[i] = static_cast<Limb>(carry);
+      carry >>= 64;
+    }
+  }
+
+  static int compare(basic_wide_integer const& a, basic_wide_integer const& b) {
+    Limb flip = Signed ? static_cast<Limb>(1) << 63 : 0;
+    for (size_t i = N; i > 0; i--) {
+      Limb x = a.limbs_[i - 1], y = b.limbs_[i - 1];
+      if (i == N) {
+        x ^= flip;
+        y ^= flip;
+      }
+      if (x != y) {
+        return x < y ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  // the quotient or the remainder of the magnitudes, with the sign rules of the built-in types; rhs != 0
+  basic_wide_integer& divide(basic_wide_integer const& rhs, bool quotient) {
+    bool negative_a = is_negative(), negative_b = rhs.is_negative();
+    basic_wide_integer a = *this, b = rhs;
+    if (negative_a) {
+      a.negate();
+    }
+    if (negative_b) {
+      b.negate();
+    }
+    size_t n = N, m = N;
+    while (n > 1 && a.limbs_[n - 1] == 0) {
+      n--;
+    }
+    while (m > 1 && b.limbs_[m - 1] == 0) {
+      m--;
+    }
+    Limb q[N + 1] = {}, r[N + 1] = {};
+    if (m == 1) {
+      r[0] = kernels::div_1(q, a.limbs_, n, b.limbs_[0]);
+    } else if (n < m) {
+      std::copy(a.limbs_, a.limbs_ + n, r);
+    } else {
+      uint32_t shift = kernels::leading_zeros(b.limbs_[m - 1]);
+      Limb d[N];
+      if (shift == 0) {
+        std::copy(b.limbs_, b.limbs_ + m, d);
+        std::copy(a.limbs_, a.limbs_ + n, r);
+      } else {
+        kernels::shl_limbs(d, b.limbs_, m, shift);
+        r[n] = kernels::shl_limbs(r, a.limbs_, n, shift);
+      }
+      q[n + 1 - m] = kernels::div_basecase(q, r, n + 1, d, m);
+      if (shift != 0) {
+        kernels::shr_limbs(r, r, m, shift);
+      }
+      std::fill(r + m, r + N + 1, 0);
+    }
+    std::copy(quotient ? q : r, (quotient ? q : r) + N, limbs_);
+    if (quotient ? negative_a != negative_b : negative_a) {
+      negate();
+    }
+    return *this;
+  }
+};
+
+template <size_t Bits>
+using wide_uint = basic_wide_integer<Bits, false>;
+template <size_t Bits>
+using wide_int = basic_wide_integer<Bits, true>;
+
+template <char... Chars>
+constexpr char wide_literal_chars[] = {Chars...};
+
+// the type of a numeric literal: parsed at the width its digits may need, then given the smallest width that holds
+// its value and a sign bit
+template <char... Chars>
+struct wide_literal
+{
+  using bound = wide_int<wide_literal_bits(wide_literal_chars<Chars...>, sizeof...(Chars))>;
+  using type = wide_int<bound::literal_bits(wide_literal_chars<Chars...>, sizeof...(Chars))>;
+};
+
+// 123_bi, 0x7b_bi, 0b1111011_bi and 0173_bi are wide_int constants just wide enough for their value and parsed by
+// the compiler, so wide_int<128> x = 170141183460469231731687303715884105727_bi needs no cast; the conversion to
+// big_integer is exact, so big_integer x = 123_bi only copies the limbs at runtime
+template <char... Chars>
+constexpr typename wide_literal<Chars...>::type operator"" _bi() {
+  using wide = typename wide_literal<Chars...>::type;
+  constexpr wide value = wide::from_literal(wide_literal_chars<Chars...>, sizeof...(Chars));
+  return value;
+}
+
+#endif // WIDE_INTEGER_H